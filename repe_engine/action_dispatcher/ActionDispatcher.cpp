@@ -3,84 +3,114 @@
 #include <iostream>           // For standard output/error (e.g., std::cout, std::cerr)
 #include <stdexcept>          // For standard exceptions (e.g., std::runtime_error)
 
-// --- ThreadPool Implementation ---
+// --- ActionDispatcher Implementation ---
+
+// Constructor for ActionDispatcher.
+// Runs every action type on a single unbounded executor with the specified number of threads.
+// @param num_threads: The number of threads for that executor.
+ActionDispatcher::ActionDispatcher(size_t num_threads)
+    : ActionDispatcher(Options{ExecutorOptions{"default", num_threads, 0, {}}, {}}) {}
 
-// Constructor for ThreadPool.
-// Initializes the worker threads and sets the stop flag to false.
-// @param num_threads: The number of threads to create in the pool.
-ThreadPool::ThreadPool(size_t num_threads) : stop_(false) {
-    // Create 'num_threads' worker threads.
-    for (size_t i = 0; i < num_threads; ++i) {
-        // Each worker thread runs a lambda function.
-        // The lambda captures 'this' to access ThreadPool's members.
-        workers_.emplace_back([this] {
-            for (;;) { // Infinite loop for worker threads.
-                std::function<void()> task; // Placeholder for the task to be executed.
-                {
-                    // Acquire a unique_lock on the queue_mutex_.
-                    std::unique_lock<std::mutex> lock(this->queue_mutex_);
-                    // Wait until either the stop_ flag is true or the tasks_ queue is not empty.
-                    // This prevents busy-waiting and efficiently puts threads to sleep when no tasks are available.
-                    this->condition_.wait(lock, [this] {
-                        return this->stop_ || !this->tasks_.empty();
-                    });
-                    // If the stop_ flag is true and the queue is empty, the thread can exit.
-                    if (this->stop_ && this->tasks_.empty())
-                        return;
-                    // Move the task from the front of the queue.
-                    task = std::move(this->tasks_.front());
-                    this->tasks_.pop(); // Remove the task from the queue.
+// Constructor for ActionDispatcher with bulkheaded executors.
+// Starts one ThreadPool per executor and builds the action type -> executor routing table.
+// @param options: The default executor and the per-type executors.
+ActionDispatcher::ActionDispatcher(const Options& options) {
+    std::vector<const ExecutorOptions*> all_options{&options.default_executor};
+    for (const auto& executor_options : options.executors) {
+        all_options.push_back(&executor_options);
+    }
+    for (const ExecutorOptions* executor_options : all_options) {
+        if (executor_options->threads == 0) {
+            throw std::invalid_argument("Executor '" + executor_options->name + "' must have at least one thread.");
+        }
+    }
+    for (size_t i = 1; i < all_options.size(); ++i) {
+        for (const auto& action_type : all_options[i]->action_types) {
+            for (const auto& route : routes_) {
+                if (route.action_type == action_type) {
+                    throw std::invalid_argument("Action type '" + action_type + "' is assigned to more than one executor.");
                 }
-                task(); // Execute the task.
             }
-        });
+            routes_.push_back(Route{action_type, nullptr});
+        }
     }
-}
 
-// Destructor for ThreadPool.
-// Signals all worker threads to stop and joins them.
-ThreadPool::~ThreadPool() {
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_); // Acquire lock to set stop_ flag safely.
-        stop_ = true; // Set the stop flag to true.
+    // All checks passed: start the pools and point the routes at them.
+    size_t route = 0;
+    for (size_t i = 0; i < all_options.size(); ++i) {
+        executors_.push_back(std::make_unique<Executor>(*all_options[i]));
+        std::cout << "[ActionDispatcher] Executor '" << all_options[i]->name << "': " << all_options[i]->threads
+                  << " threads, queue capacity " << all_options[i]->queue_capacity << "." << std::endl;
+        if (i == 0) {
+            continue; // The default executor has no routes of its own.
+        }
+        for (size_t j = 0; j < all_options[i]->action_types.size(); ++j) {
+            routes_[route++].executor = executors_.back().get();
+        }
     }
-    condition_.notify_all(); // Notify all waiting worker threads to wake up and check the stop_ flag.
-    // Join all worker threads to ensure they complete their current tasks and exit gracefully.
-    for (std::thread &worker : workers_)
-        worker.join();
 }
 
-// --- ActionDispatcher Implementation ---
-
-// Constructor for ActionDispatcher.
-// Initializes the internal ThreadPool with the specified number of threads.
-// @param num_threads: The number of threads for the internal ThreadPool.
-ActionDispatcher::ActionDispatcher(size_t num_threads) : action_thread_pool_(num_threads) {}
+// Finds the executor for an action type; unassigned types run on the default executor.
+ActionDispatcher::Executor& ActionDispatcher::executorFor(std::string_view action_type) {
+    for (const auto& route : routes_) {
+        if (route.action_type == action_type) {
+            return *route.executor;
+        }
+    }
+    return *executors_.front();
+}
 
-// Dispatches a list of action configurations for execution.
-// It iterates through the configurations, creates corresponding ActionCommand objects
-// using ActionFactory, and enqueues them for asynchronous execution in the thread pool.
-// @param actions_config: A vector of nlohmann::json objects, each representing an action's configuration.
-// @param event: The Event object that triggered these actions (passed to ActionCommand::execute).
-void ActionDispatcher::dispatch(const std::vector<nlohmann::json>& actions_config, const Event& event) {
-    for (const auto& action_cfg : actions_config) {
+// Dispatches a list of prebuilt action commands for execution on their executors.
+// @param actions: The actions triggered by matching rules (see RuleManager::evaluate).
+// @param event: Immutable snapshot of the Event that triggered these actions (passed to ActionCommand::execute).
+void ActionDispatcher::dispatch(const std::vector<ActionCommandRef>& actions, EventRef event) {
+    for (const auto& action : actions) {
+        Executor& executor = executorFor(action->type());
         try {
-            // Use ActionFactory to create an ActionCommand object from the JSON configuration.
-            std::unique_ptr<IActionCommand> action = ActionFactory::createAction(action_cfg);
-
-            // Enqueue the action for asynchronous execution in the thread pool.
-            // The lambda captures the unique_ptr to the action by move semantics (action = std::move(action))
-            // to transfer ownership to the lambda.
-            // The Event object is captured by const reference (&event) as it might be large and shared.
-            action_thread_pool_.enqueue([action = std::move(action), &event]() {
-                action->execute(event); // Execute the action command.
-            });
+            // Submit the action for asynchronous execution on its executor's thread pool.
+            // Fire-and-forget: nobody waits for the result, so no packaged_task or future is created,
+            // and the closure is stored inline in the pool's recycled Task slots (no heap allocation).
+            // The lambda shares ownership of the immutable action, so it stays valid even if
+            // the rules are reloaded before it runs.
+            // The Event snapshot is shared the same way: the caller may discard or recycle its own
+            // Event right after dispatch, and the snapshot is released once the last action has run.
+            auto run = [action, event]() {
+                action->execute(*event); // Execute the action command.
+            };
+            static_assert(Task::fitsInline<decltype(run)>(), "Action closures must fit Task's inline storage.");
+            if (executor.pool.trySubmit(std::move(run))) {
+                executor.submitted.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                // The executor is saturated: shed this action rather than let its backlog grow.
+                executor.rejected.fetch_add(1, std::memory_order_relaxed);
+                std::cerr << "[ActionDispatcher WARNING] Executor '" << executor.options.name << "' queue is full ("
+                          << executor.options.queue_capacity << "). Dropping '" << action->type()
+                          << "' action for event ID: " << formatEventId(event->id) << std::endl;
+            }
 
         } catch (const std::exception& e) {
-            // Log any errors that occur during action creation or enqueueing.
+            // Log any errors that occur while enqueueing.
             std::cerr << "[ActionDispatcher ERROR] Error dispatching action: " << e.what() << std::endl;
             // Depending on requirements, you might want to implement more sophisticated error handling,
             // such as retries, dead-letter queues, or sending alerts.
         }
     }
 }
+
+// Returns the metrics of every executor (the default executor first).
+std::vector<ActionDispatcher::ExecutorStats> ActionDispatcher::executorStats() const {
+    std::vector<ExecutorStats> stats;
+    stats.reserve(executors_.size());
+    for (const auto& executor : executors_) {
+        ExecutorStats s;
+        s.name = executor->options.name;
+        s.threads = executor->pool.size();
+        s.queue_capacity = executor->options.queue_capacity;
+        s.queue_depth = executor->pool.queuedCount();
+        s.active = executor->pool.activeCount();
+        s.submitted = executor->submitted.load(std::memory_order_relaxed);
+        s.rejected = executor->rejected.load(std::memory_order_relaxed);
+        stats.push_back(std::move(s));
+    }
+    return stats;
+}
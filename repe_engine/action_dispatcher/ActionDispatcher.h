@@ -3,83 +3,97 @@
 
 #include "actions/ActionFactory.h" // Include ActionFactory to create actions
 #include "common/Event.h"         // Include Event structure
+#include "action_dispatcher/ThreadPool.h" // Work-stealing pool that runs the actions
 #include <vector>                 // For std::vector
+#include <string>                 // For executor names and action types
+#include <string_view>            // For IActionCommand::type()
 #include <memory>                 // For std::unique_ptr
-#include <thread>                 // For std::thread (used in ThreadPool)
-#include <queue>                  // For std::queue (used in ThreadPool)
-#include <mutex>                  // For std::mutex (used in ThreadPool)
-#include <condition_variable>     // For std::condition_variable (used in ThreadPool)
-#include <future>                 // For std::future and std::packaged_task (used in ThreadPool)
-#include <functional>             // For std::function
+#include <atomic>                 // For the per-executor counters
+#include <cstdint>                // For uint64_t
 
-// Simple ThreadPool class to execute tasks asynchronously.
-// This helps in offloading action execution from the main RuleEngine thread.
-class ThreadPool {
+// ActionDispatcher is a Facade that provides a simplified interface for the RuleEngine
+// to request the execution of actions. The action commands are built once per rule when the
+// rules are loaded (Rule::buildActions); the dispatcher only executes them asynchronously.
+//
+// Actions run on bulkheaded executors: each executor is its own ThreadPool with its own thread count
+// and queue bound, serving the action types (IActionCommand::type()) assigned to it. Types that are not
+// assigned to any executor run on the default executor. A misbehaving action type (e.g. hanging shell
+// commands or slow HTTP requests) can then only exhaust its own executor: actions of the other
+// executors keep their latency, and once its queue bound is reached further actions of that executor are
+// rejected (counted in ExecutorStats::rejected) instead of piling up.
+class ActionDispatcher {
 public:
-    // Constructor: Initializes the thread pool with a specified number of worker threads.
-    // @param num_threads: The number of threads in the pool.
-    ThreadPool(size_t num_threads);
+    // Configuration of one executor.
+    struct ExecutorOptions {
+        std::string name;                      // Executor name (for logs and metrics).
+        size_t threads = 1;                    // Worker threads of this executor.
+        size_t queue_capacity = 0;             // Maximum actions waiting to run; 0 = no limit.
+        std::vector<std::string> action_types; // Action types (ActionFactory names) routed here.
+    };
 
-    // Destructor: Stops all worker threads and joins them.
-    ~ThreadPool();
+    // Configuration of the dispatcher.
+    struct Options {
+        // Runs every action type that is not assigned to one of 'executors' (its action_types are ignored).
+        ExecutorOptions default_executor{"default", 4, 0, {}};
+        std::vector<ExecutorOptions> executors;
+    };
 
-    // Enqueues a task (a callable object) into the thread pool's task queue.
-    // The task will be executed by one of the worker threads.
-    // @param f: The callable object (function, lambda, functor) to be executed.
-    // @return A std::future that will hold the result of the task's execution.
-    template<class F>
-    auto enqueue(F&& f) -> std::future<typename std::result_of<F()>::type>;
+    // Snapshot of one executor's metrics.
+    struct ExecutorStats {
+        std::string name;
+        size_t threads = 0;         // Worker threads.
+        size_t queue_capacity = 0;  // Queue bound; 0 = no limit.
+        size_t queue_depth = 0;     // Actions submitted but not yet started.
+        size_t active = 0;          // Threads currently running an action (== threads when saturated).
+        uint64_t submitted = 0;     // Actions accepted since start.
+        uint64_t rejected = 0;      // Actions dropped because the queue was full.
 
-private:
-    std::vector<std::thread> workers_;           // Vector to hold the worker threads.
-    std::queue<std::function<void()>> tasks_;    // Queue of tasks to be executed.
-    std::mutex queue_mutex_;                     // Mutex to protect access to the task queue.
-    std::condition_variable condition_;          // Condition variable to signal workers about new tasks.
-    bool stop_;                                  // Flag to signal threads to stop.
-};
-
-// ActionDispatcher is a Facade that provides a simplified interface for the RuleEngine
-// to request the execution of actions. It uses ActionFactory to create action commands
-// and can use a ThreadPool to execute them asynchronously.
-class ActionDispatcher {
-private:
-    ThreadPool action_thread_pool_; // Thread Pool to execute actions asynchronously.
+        // Fraction of the executor's threads that are busy (0..1).
+        double saturation() const { return threads == 0 ? 0.0 : static_cast<double>(active) / threads; }
+    };
 
-public:
     // Constructor for ActionDispatcher.
-    // @param num_threads: The number of threads for the internal ThreadPool.
+    // Runs every action type on a single unbounded executor.
+    // @param num_threads: The number of threads for that executor.
     ActionDispatcher(size_t num_threads = 4); // Default to 4 threads.
 
-    // Dispatches a list of action configurations for execution.
-    // It iterates through the configurations, creates corresponding ActionCommand objects
-    // using ActionFactory, and enqueues them for asynchronous execution.
-    // @param actions_config: A vector of nlohmann::json objects, each representing an action's configuration.
-    // @param event: The Event object that triggered these actions (passed to ActionCommand::execute).
-    void dispatch(const std::vector<nlohmann::json>& actions_config, const Event& event);
-};
+    // Constructor for ActionDispatcher with bulkheaded executors.
+    // @param options: The default executor and the per-type executors.
+    // @throws std::invalid_argument if an executor has no threads or an action type is assigned twice.
+    explicit ActionDispatcher(const Options& options);
 
-// Template implementation for ThreadPool::enqueue.
-// This needs to be in the header file because it's a template function.
-template<class F>
-auto ThreadPool::enqueue(F&& f) -> std::future<typename std::result_of<F()>::type> {
-    // Define the return type of the packaged task.
-    using return_type = typename std::result_of<F()>::type;
+    // Dispatches a list of prebuilt action commands for execution.
+    // Each action is submitted to the executor of its type; only its reference count is touched,
+    // no action is created or copied.
+    // @param actions: The actions triggered by matching rules (see RuleManager::evaluate).
+    // @param event: Immutable snapshot of the Event that triggered these actions (passed to ActionCommand::execute).
+    //               Every enqueued action shares it, so it outlives the caller's copy without being copied per action.
+    void dispatch(const std::vector<ActionCommandRef>& actions, EventRef event);
 
-    // Create a packaged_task to wrap the function 'f' and get a future for its result.
-    auto task = std::make_shared<std::packaged_task<return_type()>>(std::forward<F>(f));
+    // Returns the metrics of every executor (the default executor first).
+    std::vector<ExecutorStats> executorStats() const;
 
-    std::future<return_type> res = task->get_future(); // Get the future associated with the task.
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_); // Lock the queue for safe access.
+private:
+    // One bulkhead: a ThreadPool and its counters.
+    struct Executor {
+        explicit Executor(const ExecutorOptions& executor_options)
+            : options(executor_options), pool(executor_options.threads, executor_options.queue_capacity) {}
 
-        // Don't allow enqueueing tasks if the pool is stopped.
-        if(stop_)
-            throw std::runtime_error("enqueue on stopped ThreadPool");
+        ExecutorOptions options;
+        ThreadPool pool;
+        std::atomic<uint64_t> submitted{0};
+        std::atomic<uint64_t> rejected{0};
+    };
 
-        // Add the task (wrapped in a lambda) to the queue.
-        // The lambda captures the shared_ptr to the packaged_task.
-        tasks_.emplace([task](){ (*task)(); });
-    }
-    condition_.notify_one(); // Notify one waiting worker thread that a new task is available.
-    return res; // Return the future to the caller.
-}
+    // Routing entry: action type -> executor.
+    struct Route {
+        std::string action_type;
+        Executor* executor;
+    };
+
+    // Finds the executor for an action type (a linear scan: there are only a handful of types).
+    Executor& executorFor(std::string_view action_type);
+
+    std::vector<Route> routes_;
+    std::vector<std::unique_ptr<Executor>> executors_; // executors_[0] is the default executor.
+};
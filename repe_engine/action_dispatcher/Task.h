@@ -0,0 +1,109 @@
+// action_dispatcher/Task.h
+#pragma once
+
+#include <cstddef>      // For std::size_t, std::max_align_t
+#include <new>          // For placement new
+#include <type_traits>  // For std::decay_t, std::enable_if_t
+#include <utility>      // For std::move, std::forward
+
+// Task is a move-only, type-erased `void()` callable with small-buffer storage.
+//
+// Unlike std::function it does not require the callable to be copyable (so a std::packaged_task
+// can be stored directly), and it keeps callables of up to kInlineSize bytes inline instead of on
+// the heap. kInlineSize is sized for the ThreadPool's own closures: an ActionDispatcher closure holds
+// an ActionCommandRef and an EventRef (two shared_ptrs), and ThreadPool::enqueue stores a
+// std::packaged_task. Larger (or throwing-move) callables still work but are heap-allocated.
+class Task {
+public:
+    // Bytes of inline storage.
+    static constexpr std::size_t kInlineSize = 48;
+
+    // True if a callable of type F is stored inline (no heap allocation).
+    template <class F>
+    static constexpr bool fitsInline() {
+        using Fn = std::decay_t<F>;
+        return sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Fn>::value;
+    }
+
+    Task() noexcept = default;
+
+    // Constructor: Stores any callable invocable as `void()`.
+    template <class F, class = std::enable_if_t<!std::is_same<std::decay_t<F>, Task>::value>>
+    Task(F&& f) {
+        using Fn = std::decay_t<F>;
+        if constexpr (fitsInline<Fn>()) {
+            new (storage_) Fn(std::forward<F>(f));
+            ops_ = &InlineOps<Fn>::ops;
+        } else {
+            *reinterpret_cast<Fn**>(storage_) = new Fn(std::forward<F>(f));
+            ops_ = &HeapOps<Fn>::ops;
+        }
+    }
+
+    Task(Task&& other) noexcept { moveFrom(other); }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() { reset(); }
+
+    // Runs the stored callable. The Task must not be empty.
+    void operator()() { ops_->invoke(storage_); }
+
+    // Destroys the stored callable (releasing whatever it captured); the Task becomes empty.
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+private:
+    // Per-callable-type operations (a hand-rolled vtable).
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept; // Move-constructs into dst and destroys src.
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <class Fn>
+    struct InlineOps {
+        static void invoke(void* storage) { (*static_cast<Fn*>(storage))(); }
+        static void move(void* dst, void* src) noexcept {
+            new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            static_cast<Fn*>(src)->~Fn();
+        }
+        static void destroy(void* storage) noexcept { static_cast<Fn*>(storage)->~Fn(); }
+        static constexpr Ops ops{&invoke, &move, &destroy};
+    };
+
+    template <class Fn>
+    struct HeapOps {
+        static void invoke(void* storage) { (**static_cast<Fn**>(storage))(); }
+        static void move(void* dst, void* src) noexcept { *static_cast<Fn**>(dst) = *static_cast<Fn**>(src); }
+        static void destroy(void* storage) noexcept { delete *static_cast<Fn**>(storage); }
+        static constexpr Ops ops{&invoke, &move, &destroy};
+    };
+
+    void moveFrom(Task& other) noexcept {
+        if (other.ops_) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+    const Ops* ops_ = nullptr;
+};
@@ -0,0 +1,172 @@
+// action_dispatcher/ThreadPool.cpp
+#include "ThreadPool.h" // Include the header for ThreadPool
+#include <iostream>     // For error output (std::cerr)
+
+namespace {
+// The pool and worker index of the current thread, if it is a ThreadPool worker.
+// Lets push() put tasks submitted from a worker on that worker's own deque.
+struct CurrentWorker {
+    const ThreadPool* pool = nullptr;
+    size_t index = 0;
+};
+thread_local CurrentWorker current_worker;
+} // namespace
+
+// Constructor for ThreadPool.
+// Creates one deque per worker, then starts the worker threads.
+// @param num_threads: The number of threads to create in the pool.
+// @param max_queued: Maximum number of waiting tasks accepted by trySubmit(); 0 = no limit.
+ThreadPool::ThreadPool(size_t num_threads, size_t max_queued)
+    : injection_(kInjectionCapacity), free_slots_(kInjectionCapacity), max_queued_(max_queued) {
+    for (size_t i = 0; i < num_threads; ++i) {
+        deques_.push_back(std::make_unique<WorkStealingDeque<Task>>());
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+// Destructor for ThreadPool.
+// Signals all worker threads to stop and joins them. Workers only exit once every submitted task has run.
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(park_mutex_); // Acquire lock so no worker misses the wake-up.
+        stop_.store(true);
+    }
+    condition_.notify_all(); // Wake all parked workers so they drain the queues and exit.
+    for (std::thread &worker : workers_)
+        worker.join();
+    // Every task has run: all slots are back in the free list (or were deleted when it was full).
+    Task* slot = nullptr;
+    while (free_slots_.tryPop(slot)) {
+        delete slot;
+    }
+}
+
+// Takes an empty Task slot from the free list, allocating one only while the pool warms up.
+Task* ThreadPool::acquireSlot() {
+    Task* slot = nullptr;
+    if (free_slots_.tryPop(slot)) {
+        return slot;
+    }
+    return new Task();
+}
+
+// Empties a Task slot after its task has run and returns it to the free list.
+void ThreadPool::recycleSlot(Task* slot) {
+    slot->reset(); // Release what the task captured now, not when the slot is reused.
+    if (!free_slots_.tryPush(slot)) {
+        delete slot;
+    }
+}
+
+// Hands a task to the pool: to the calling worker's deque, or to the injection queue.
+// Wakes a parked worker if there is one.
+// @param bounded: true to reject the task when max_queued_ tasks are already waiting.
+// @return false if the task was rejected.
+bool ThreadPool::push(Task&& task, bool bounded) {
+    // Don't allow enqueueing tasks from outside once the pool is stopped. A running task may still
+    // submit follow-up tasks: its worker cannot exit before they have run as well.
+    const bool from_worker = current_worker.pool == this;
+    if (!from_worker && stop_.load(std::memory_order_relaxed))
+        throw std::runtime_error("enqueue on stopped ThreadPool");
+
+    // Count the task before publishing it. queued_ and sleepers_ are both seq_cst: either a parking
+    // worker sees queued_ > 0, or this producer (which reads sleepers_ afterwards) sees it parked and wakes it.
+    if (bounded && max_queued_ > 0) {
+        size_t queued = queued_.load();
+        do {
+            if (queued >= max_queued_) {
+                return false;
+            }
+        } while (!queued_.compare_exchange_weak(queued, queued + 1));
+    } else {
+        queued_.fetch_add(1);
+    }
+
+    Task* raw = acquireSlot(); // The slot moves with the pointer until a worker runs it.
+    *raw = std::move(task);
+    if (from_worker) {
+        deques_[current_worker.index]->push(raw);
+    } else if (!injection_.tryPush(raw)) {
+        std::unique_lock<std::mutex> lock(overflow_mutex_);
+        overflow_.push_back(raw);
+        overflow_size_.fetch_add(1);
+    }
+
+    if (sleepers_.load() > 0) {
+        { std::unique_lock<std::mutex> lock(park_mutex_); }
+        condition_.notify_one();
+    }
+    return true;
+}
+
+// Looks for a task for worker 'index': own deque, injection queue, overflow queue,
+// then the other workers' deques (starting after 'index' so thieves spread out).
+// @return The task, or nullptr if none was found in this round.
+Task* ThreadPool::findTask(size_t index) {
+    if (Task* task = deques_[index]->pop()) {
+        return task;
+    }
+    Task* task = nullptr;
+    if (injection_.tryPop(task)) {
+        return task;
+    }
+    if (overflow_size_.load(std::memory_order_relaxed) > 0) {
+        std::unique_lock<std::mutex> lock(overflow_mutex_);
+        if (!overflow_.empty()) {
+            task = overflow_.front();
+            overflow_.pop_front();
+            overflow_size_.fetch_sub(1);
+            return task;
+        }
+    }
+    for (size_t i = 1; i < deques_.size(); ++i) {
+        if (Task* stolen = deques_[(index + i) % deques_.size()]->steal()) {
+            return stolen;
+        }
+    }
+    return nullptr;
+}
+
+// Worker thread: runs tasks until the pool is stopped and no task is left.
+// Spins (yielding) for a while when idle, then parks until a task is submitted.
+void ThreadPool::workerLoop(size_t index) {
+    current_worker.pool = this;
+    current_worker.index = index;
+    int idle_rounds = 0;
+    for (;;) {
+        if (Task* task = findTask(index)) {
+            queued_.fetch_sub(1);
+            active_.fetch_add(1, std::memory_order_relaxed);
+            idle_rounds = 0;
+            try {
+                (*task)(); // Execute the task.
+            } catch (const std::exception& e) {
+                // Only submit() tasks get here; enqueue() stores exceptions in the future.
+                std::cerr << "[ThreadPool ERROR] Task threw an exception: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "[ThreadPool ERROR] Task threw an unknown exception." << std::endl;
+            }
+            active_.fetch_sub(1, std::memory_order_relaxed);
+            recycleSlot(task);
+            continue;
+        }
+        if (queued_.load() > 0 || ++idle_rounds < kSpinRounds) {
+            std::this_thread::yield(); // A task is in flight or may arrive soon: keep looking.
+            continue;
+        }
+
+        // Park until a task is submitted or the pool stops.
+        std::unique_lock<std::mutex> lock(park_mutex_);
+        sleepers_.fetch_add(1);
+        condition_.wait(lock, [this] {
+            return stop_.load() || queued_.load() > 0;
+        });
+        sleepers_.fetch_sub(1);
+        // If the pool is stopping and every task has been taken, the thread can exit.
+        if (stop_.load() && queued_.load() == 0)
+            return;
+        idle_rounds = 0;
+    }
+}
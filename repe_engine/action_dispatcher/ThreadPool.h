@@ -0,0 +1,141 @@
+// action_dispatcher/ThreadPool.h
+#pragma once
+
+#include "action_dispatcher/Task.h"              // Move-only task with inline storage
+#include "action_dispatcher/WorkStealingDeque.h" // Per-worker task deques
+#include "core/MpmcRingBuffer.h"                 // Lock-free global injection queue
+#include <vector>                 // For std::vector
+#include <deque>                  // For the injection overflow queue
+#include <memory>                 // For std::unique_ptr
+#include <thread>                 // For std::thread
+#include <atomic>                 // For std::atomic
+#include <mutex>                  // For std::mutex (parking and overflow only)
+#include <condition_variable>     // For parking idle workers
+#include <future>                 // For std::future and std::packaged_task
+#include <stdexcept>              // For std::runtime_error
+#include <type_traits>            // For std::result_of
+
+// Work-stealing ThreadPool to execute tasks asynchronously.
+// This helps in offloading action execution from the RuleEngine threads.
+//
+// - Tasks submitted from outside the pool go to a global injection queue: a lock-free
+//   MpmcRingBuffer, with a mutex-protected overflow queue used only when the ring is full.
+// - Tasks submitted from a worker thread go to that worker's own Chase-Lev deque
+//   (WorkStealingDeque) and are popped LIFO by the worker.
+// - An idle worker looks in its own deque, then the injection queue, then steals from the other
+//   workers' deques. After kSpinRounds fruitless rounds it parks on a condition variable.
+//   Producers only touch the mutex to wake a worker when one is actually parked.
+// - Tasks are stored as Task objects (inline storage, no std::function). The Task slots handed
+//   around the queues are recycled through a lock-free free list, so once the pool is warm
+//   submit() of a callable that fits Task's inline buffer performs no heap allocation.
+//
+// Tasks from one producer may run out of submission order (the pool has several workers anyway).
+// The destructor runs every task that was already submitted (including tasks those tasks submit)
+// before joining the workers.
+class ThreadPool {
+public:
+    // Constructor: Initializes the thread pool with a specified number of worker threads.
+    // @param num_threads: The number of threads in the pool.
+    // @param max_queued: Maximum number of tasks waiting to run accepted by trySubmit(); 0 = no limit.
+    //                    enqueue() and submit() are never limited.
+    ThreadPool(size_t num_threads, size_t max_queued = 0);
+
+    // Destructor: Runs the remaining tasks, stops all worker threads and joins them.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Enqueues a task (a callable object) into the thread pool.
+    // The task will be executed by one of the worker threads.
+    // @param f: The callable object (function, lambda, functor) to be executed.
+    // Creating the std::future's shared state allocates; use submit() when the result is not needed.
+    // @return A std::future that will hold the result of the task's execution.
+    // @throws std::runtime_error if the pool is stopping and the caller is not one of its workers.
+    template<class F>
+    auto enqueue(F&& f) -> std::future<typename std::result_of<F()>::type>;
+
+    // Submits a fire-and-forget task: no std::packaged_task or std::future is created.
+    // Allocation-free in steady state when Task::fitsInline<F>().
+    // An exception escaping the task is logged by the worker and otherwise ignored.
+    // @param f: The callable object to be executed.
+    // @throws std::runtime_error if the pool is stopping and the caller is not one of its workers.
+    template<class F>
+    void submit(F&& f);
+
+    // Submits a fire-and-forget task unless max_queued tasks are already waiting to run.
+    // Lets a caller shed load instead of letting the backlog grow without bound.
+    // @param f: The callable object to be executed (only moved from when accepted).
+    // @return false if the task was rejected because the queue is full.
+    // @throws std::runtime_error if the pool is stopping and the caller is not one of its workers.
+    template<class F>
+    bool trySubmit(F&& f);
+
+    size_t size() const { return workers_.size(); }
+    size_t maxQueued() const { return max_queued_; }
+    // Tasks submitted but not yet started (queue depth).
+    size_t queuedCount() const { return queued_.load(std::memory_order_relaxed); }
+    // Workers currently running a task; equal to size() when the pool is saturated.
+    size_t activeCount() const { return active_.load(std::memory_order_relaxed); }
+
+private:
+    // Number of search rounds (own deque, injection queue, steal) an idle worker makes,
+    // yielding between rounds, before it parks.
+    static constexpr int kSpinRounds = 64;
+    // Slots of the lock-free injection ring (a power of two); also the number of idle Task slots kept.
+    static constexpr size_t kInjectionCapacity = 4096;
+
+    bool push(Task&& task, bool bounded);
+    Task* acquireSlot();
+    void recycleSlot(Task* slot);
+    Task* findTask(size_t index);
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<WorkStealingDeque<Task>>> deques_; // One per worker.
+    MpmcRingBuffer<Task*> injection_;            // Tasks submitted from outside the pool.
+    std::deque<Task*> overflow_;                 // Used when injection_ is full (guarded by overflow_mutex_).
+    std::mutex overflow_mutex_;
+    std::atomic<size_t> overflow_size_{0};       // Lets workers skip overflow_mutex_ while the overflow queue is empty.
+    MpmcRingBuffer<Task*> free_slots_;           // Empty Task slots ready for reuse.
+
+    const size_t max_queued_;                    // Bound for trySubmit(); 0 = no limit.
+    alignas(kCacheLineSize) std::atomic<size_t> queued_{0}; // Submitted tasks not yet taken by a worker.
+    alignas(kCacheLineSize) std::atomic<size_t> active_{0}; // Workers running a task.
+    alignas(kCacheLineSize) std::atomic<size_t> sleepers_{0}; // Workers parked (or about to park) on condition_.
+    std::mutex park_mutex_;                      // Mutex for condition_ (and for setting stop_).
+    std::condition_variable condition_;          // Wakes parked workers.
+    std::atomic<bool> stop_{false};              // Flag to signal threads to stop.
+    std::vector<std::thread> workers_;           // Vector to hold the worker threads.
+};
+
+// Template implementation for ThreadPool::enqueue.
+// This needs to be in the header file because it's a template function.
+template<class F>
+auto ThreadPool::enqueue(F&& f) -> std::future<typename std::result_of<F()>::type> {
+    // Define the return type of the packaged task.
+    using return_type = typename std::result_of<F()>::type;
+
+    // Create a packaged_task to wrap the function 'f' and get a future for its result.
+    std::packaged_task<return_type()> task(std::forward<F>(f));
+
+    std::future<return_type> res = task.get_future(); // Get the future associated with the task.
+    // Task is move-only, so the packaged_task is stored in it directly (inline, no shared_ptr wrapper).
+    push(Task(std::move(task)), false);
+    return res; // Return the future to the caller.
+}
+
+// Template implementation for ThreadPool::submit.
+template<class F>
+void ThreadPool::submit(F&& f) {
+    push(Task(std::forward<F>(f)), false);
+}
+
+// Template implementation for ThreadPool::trySubmit.
+template<class F>
+bool ThreadPool::trySubmit(F&& f) {
+    if (max_queued_ > 0 && queuedCount() >= max_queued_) {
+        return false; // Cheap early rejection; push() re-checks the bound atomically.
+    }
+    Task task(std::forward<F>(f));
+    return push(std::move(task), true);
+}
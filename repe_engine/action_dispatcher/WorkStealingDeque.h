@@ -0,0 +1,125 @@
+// action_dispatcher/WorkStealingDeque.h
+#pragma once
+
+#include "core/MpmcRingBuffer.h" // For kCacheLineSize
+#include <atomic>                // For std::atomic (indices, slots, buffer pointer)
+#include <cstdint>               // For std::int64_t
+#include <memory>                // For std::unique_ptr
+#include <vector>                // For retired buffers
+
+// WorkStealingDeque is a Chase-Lev work-stealing deque of pointers
+// ("Dynamic Circular Work-Stealing Deque", with the C11 memory orderings of Le et al., 2013).
+//
+// One owner thread pushes and pops at the bottom (LIFO, so the task it just produced is still
+// in cache); any other thread may steal from the top (FIFO, the oldest task). push/pop touch no
+// shared cache line unless the deque is nearly empty, and a steal is a single CAS on top_.
+//
+// The deque stores raw pointers only: a thief reads a slot before it knows whether its CAS wins,
+// so slots must be atomically readable. Ownership of the pointee moves with the pointer.
+// The buffer grows when full; old buffers are retired and freed with the deque, because a thief may
+// still be reading from one.
+template <typename T>
+class WorkStealingDeque {
+public:
+    // Constructor.
+    // @param capacity: Initial number of slots (rounded up to a power of two).
+    explicit WorkStealingDeque(std::int64_t capacity = 256) {
+        std::int64_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        buffers_.push_back(std::make_unique<Buffer>(size));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Pushes an item at the bottom. Owner thread only.
+    void push(T* item) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if (b - t > buffer->size - 1) {
+            buffer = grow(buffer, t, b);
+        }
+        buffer->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Pops the most recently pushed item. Owner thread only.
+    // @return The item, or nullptr if the deque is empty (or a thief took the last item).
+    T* pop() {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed); // Empty.
+            return nullptr;
+        }
+        T* item = buffer->get(b);
+        if (t == b) {
+            // Last item: race the thieves for it.
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // Steals the oldest item. Any thread.
+    // @return The item, or nullptr if the deque is empty or another thread won the race.
+    T* steal() {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+        T* item = buffer_.load(std::memory_order_acquire)->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    // Approximate number of items; exact only without concurrent operations.
+    std::int64_t sizeApprox() const {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(std::int64_t n) : size(n), mask(n - 1), slots(new std::atomic<T*>[n]) {}
+
+        T* get(std::int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(std::int64_t i, T* item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+
+        const std::int64_t size;
+        const std::int64_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+    };
+
+    // Doubles the buffer, copying the live range [t, b). Owner thread only.
+    Buffer* grow(Buffer* old_buffer, std::int64_t t, std::int64_t b) {
+        buffers_.push_back(std::make_unique<Buffer>(old_buffer->size * 2));
+        Buffer* buffer = buffers_.back().get();
+        for (std::int64_t i = t; i < b; ++i) {
+            buffer->put(i, old_buffer->get(i));
+        }
+        buffer_.store(buffer, std::memory_order_release);
+        return buffer;
+    }
+
+    // top_ is written by thieves, bottom_ by the owner: keep them on separate cache lines.
+    alignas(kCacheLineSize) std::atomic<std::int64_t> top_{0};
+    alignas(kCacheLineSize) std::atomic<std::int64_t> bottom_{0};
+    std::atomic<Buffer*> buffer_{nullptr};
+    std::vector<std::unique_ptr<Buffer>> buffers_; // Current and retired buffers (owner thread only).
+};
@@ -27,7 +27,12 @@ std::unique_ptr<IActionCommand> ActionFactory::createAction(const nlohmann::json
     auto it = creators_.find(action_type);
     if (it != creators_.end()) {
         std::cout << "[ActionFactory] Creating action type: " << action_type << std::endl;
-        return it->second(action_config); // Call the registered creator function.
+        std::unique_ptr<IActionCommand> action = it->second(action_config); // Call the registered creator function.
+        if (!action) {
+            throw std::runtime_error("Creator for action type '" + action_type + "' returned no action.");
+        }
+        action->type_ = std::move(action_type); // The registered name routes the action (IActionCommand::type()).
+        return action;
     } else {
         // If the action type is not found in the map, it's an unknown type.
         throw std::runtime_error("Unknown action type: " + action_type);
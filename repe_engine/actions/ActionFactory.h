@@ -19,7 +19,7 @@ public:
     // Phương thức tĩnh createAction: Factory Method chính để tạo Action từ JSON config.
     // Nó sẽ tìm hàm tạo phù hợp dựa trên trường "type" trong action_config và gọi nó.
     // @param action_config: Đối tượng JSON chứa cấu hình của hành động cần tạo.
-    // @return unique_ptr tới đối tượng IActionCommand đã được tạo.
+    // @return unique_ptr tới đối tượng IActionCommand đã được tạo; type() của nó là trường "type".
     // @throws std::runtime_error nếu cấu hình không hợp lệ hoặc loại hành động không xác định.
     static std::unique_ptr<IActionCommand> createAction(const nlohmann::json& action_config);
 
@@ -3,6 +3,7 @@
 #include <iostream>     // For standard output/error (e.g., std::cout, std::cerr)
 #include <stdexcept>    // For standard exceptions (e.g., std::runtime_error)
 #include <string>       // For std::string operations
+#include "common/EventValueJson.h" // For eventValueToJson
 
 // Constructor for HttpAction.
 // Initializes the URL, HTTP method, and payload template from the provided JSON configuration.
@@ -52,11 +53,9 @@ void HttpAction::execute(const Event& event) const {
                     auto it = event.data.find(event_key); // Find the key in the event's data map.
 
                     if (it != event.data.end()) {
-                        // Use std::visit to convert the EventValue (std::variant) to a nlohmann::json value.
-                        // nlohmann::json can be constructed directly from basic types like int, double, bool, string.
-                        final_payload[key] = std::visit([](auto&& arg) -> nlohmann::json {
-                            return arg;
-                        }, it->second);
+                        // Convert the EventValue to a JSON value of the same type: numeric arrays
+                        // stay JSON arrays and 64-bit integers keep their full precision.
+                        final_payload[key] = eventValueToJson(it->second);
                     } else {
                         // If the event key is not found, replace the placeholder with a "MISSING" tag.
                         final_payload[key] = "[MISSING_" + event_key + "]";
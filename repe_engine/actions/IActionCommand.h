@@ -2,6 +2,9 @@
 
 #include "common/Event.h" // Bao gồm cấu trúc Event để các hành động có thể truy cập dữ liệu sự kiện
 #include <nlohmann/json.hpp> // Để truyền cấu hình hành động (nếu cần thiết cho các hành động phức tạp)
+#include <memory>            // For std::shared_ptr
+#include <string>            // For std::string
+#include <string_view>       // For std::string_view
 
 // IActionCommand là interface cho tất cả các lệnh hành động trong hệ thống REPE.
 // Đây là Abstract Command trong Command Pattern.
@@ -17,4 +20,19 @@ public:
     // Ví dụ: một LogAction có thể log giá trị nhiệt độ từ Event.
     // @param event: Đối tượng Event chứa dữ liệu cần thiết cho hành động.
     virtual void execute(const Event& event) const = 0;
+
+    // Phương thức type: Tên loại hành động, là trường "type" của cấu hình mà ActionFactory đã dùng
+    // để tạo hành động (ví dụ "log"). ActionDispatcher dùng nó để chọn executor (bulkhead) cho hành động.
+    // @return Tên loại; rỗng nếu hành động không được tạo qua ActionFactory (chạy trên executor mặc định).
+    std::string_view type() const { return type_; }
+
+private:
+    friend class ActionFactory; // Ghi lại loại hành động khi tạo (createAction)
+
+    std::string type_;
 };
+
+// ActionCommandRef là tham chiếu (đếm tham chiếu) tới một hành động bất biến đã được tạo sẵn.
+// Rule tạo các hành động của nó một lần khi tải quy tắc; kết quả đánh giá và ActionDispatcher chỉ
+// sao chép con trỏ này, nên hành động vẫn sống khi bộ quy tắc được tải lại trong lúc nó đang chạy.
+using ActionCommandRef = std::shared_ptr<const IActionCommand>;
@@ -44,20 +44,8 @@ std::string LogAction::formatMessage(const Event& event) const {
             // Try to find the key in the event's data.
             auto it = event.data.find(key);
             if (it != event.data.end()) {
-                // Use std::visit to get the value from EventValue (std::variant) and convert it to a string.
-                std::string value_str = std::visit([](auto&& arg) -> std::string {
-                    // Use if constexpr (C++17) for compile-time type checking.
-                    if constexpr (std::is_same_v<decltype(arg), int>) {
-                        return std::to_string(arg);
-                    } else if constexpr (std::is_same_v<decltype(arg), double>) {
-                        return std::to_string(arg); // Convert double to string
-                    } else if constexpr (std::is_same_v<decltype(arg), bool>) {
-                        return arg ? "true" : "false"; // Convert bool to "true" or "false"
-                    } else if constexpr (std::is_same_v<decltype(arg), std::string>) {
-                        return arg; // String is already a string
-                    }
-                    return "[Unsupported Type]"; // Fallback for unsupported types in EventValue
-                }, it->second);
+                // Convert the EventValue (numbers, strings, arrays, blobs) to its text form.
+                std::string value_str = eventValueToString(it->second);
 
                 // Replace the placeholder with the actual value string.
                 result.replace(start_pos, end_pos - start_pos + 1, value_str);
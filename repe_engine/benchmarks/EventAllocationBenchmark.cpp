@@ -0,0 +1,118 @@
+// benchmarks/EventAllocationBenchmark.cpp
+// Heap allocations per event on the ingest-to-dispatch path, with and without EventPool.
+//
+// Events are built by EventProcessor (processRawData and processRawJsonData), pushed
+// into an EventQueue, drained with popBatch like runRuleEngineBatched, and then either
+// dropped (no pool) or handed back with EventPool::releaseBatch. Every call to the
+// global operator new is counted; the first batches are excluded as warm-up so the
+// numbers show the steady state.
+#include "core/EventProcessor.h"
+#include "core/EventPool.h"
+#include "core/EventQueue.h"
+
+#include <algorithm> // For std::max
+#include <atomic>    // For the allocation counter
+#include <chrono>    // For timing
+#include <cstdio>    // For std::printf
+#include <cstdlib>   // For std::malloc, std::free, std::atoi
+#include <iostream>  // To silence EventProcessor logging
+#include <new>       // For std::bad_alloc
+#include <vector>    // For std::vector
+
+namespace {
+std::atomic<unsigned long long> g_allocations{0};
+} // namespace
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr size_t kBatchSize = 64;
+constexpr int kWarmupBatches = 4;
+
+struct BenchmarkResult {
+    double simple_allocs_per_event;
+    double json_allocs_per_event;
+    double events_per_sec;
+};
+
+// Runs batches of one kind of event through processor -> queue -> popBatch -> release.
+// @return Allocations per event after warm-up.
+template <typename Produce>
+double measure(EventQueue& queue, EventPool* pool, int batches, Produce produce) {
+    std::vector<Event> batch;
+    batch.reserve(kBatchSize);
+    unsigned long long allocations = 0;
+    for (int b = 0; b < kWarmupBatches + batches; ++b) {
+        unsigned long long before = g_allocations.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kBatchSize; ++i) {
+            produce(i);
+        }
+        queue.popBatch(batch, kBatchSize, std::chrono::milliseconds(0));
+        if (pool) {
+            pool->releaseBatch(batch);
+        } else {
+            batch.clear();
+        }
+        if (b >= kWarmupBatches) {
+            allocations += g_allocations.load(std::memory_order_relaxed) - before;
+        }
+    }
+    return static_cast<double>(allocations) / (static_cast<double>(batches) * kBatchSize);
+}
+
+BenchmarkResult runBenchmark(bool use_pool, int batches) {
+    EventQueue queue;
+    EventPool pool;
+    EventProcessor processor(queue, use_pool ? &pool : nullptr);
+    EventPool* release_pool = use_pool ? &pool : nullptr;
+
+    // Source and type names longer than the std::string small buffer, like real sources.
+    const std::string source = "socket_listener_port_12345";
+    const std::string type = "temperature_reading_celsius";
+    const std::string json = R"({"type": "sensor_reading", "temperature": 25.5, "humidity": 60, "location": "LivingRoom"})";
+
+    auto start = std::chrono::steady_clock::now();
+    BenchmarkResult result{};
+    result.simple_allocs_per_event = measure(queue, release_pool, batches, [&](size_t i) {
+        processor.processRawData(source, type, static_cast<int>(i), "temperature");
+    });
+    result.json_allocs_per_event = measure(queue, release_pool, batches, [&](size_t) {
+        processor.processRawJsonData(source, json);
+    });
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.events_per_sec = (2.0 * (kWarmupBatches + batches) * kBatchSize) / elapsed;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int batches = 2000;
+    if (argc > 1) {
+        batches = std::max(1, std::atoi(argv[1]));
+    }
+
+    // EventProcessor logs every event; drop that output so only the pipeline is measured.
+    std::streambuf* cout_buf = std::cout.rdbuf(nullptr);
+    BenchmarkResult without_pool = runBenchmark(false, batches);
+    BenchmarkResult with_pool = runBenchmark(true, batches);
+    std::cout.rdbuf(cout_buf);
+
+    std::printf("Event allocation benchmark: %d batches of %zu events per kind\n\n", batches, kBatchSize);
+    std::printf("%-12s %22s %20s %14s\n", "mode", "allocs/event (simple)", "allocs/event (json)", "events/s");
+    std::printf("%-12s %22.2f %20.2f %14.0f\n", "no pool", without_pool.simple_allocs_per_event,
+                without_pool.json_allocs_per_event, without_pool.events_per_sec);
+    std::printf("%-12s %22.2f %20.2f %14.0f\n", "EventPool", with_pool.simple_allocs_per_event,
+                with_pool.json_allocs_per_event, with_pool.events_per_sec);
+    return 0;
+}
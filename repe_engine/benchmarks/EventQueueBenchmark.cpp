@@ -0,0 +1,95 @@
+// benchmarks/EventQueueBenchmark.cpp
+// Throughput/latency comparison of the EventQueue backends (Mutex vs LockFree).
+//
+// N producer threads push events as fast as they can while one consumer thread
+// (like runRuleEngine) pops them with the blocking pop(). Queue latency is measured
+// from Event::timestamp (set right before push) to the moment the consumer receives it.
+#include "core/EventQueue.h"
+
+#include <algorithm> // For std::sort
+#include <chrono>    // For timing
+#include <cstdlib>   // For std::atoi
+#include <cstdio>    // For std::printf
+#include <thread>    // For std::thread
+#include <vector>    // For std::vector
+
+namespace {
+
+struct BenchmarkResult {
+    double events_per_sec;
+    double p50_us;
+    double p99_us;
+    double max_us;
+};
+
+const char* backendName(EventQueue::Backend backend) {
+    return backend == EventQueue::Backend::Mutex ? "Mutex" : "LockFree";
+}
+
+BenchmarkResult runBenchmark(EventQueue::Backend backend, int num_producers, int total_events) {
+    EventQueue queue(backend, EventQueue::kDefaultLockFreeCapacity);
+    const int events_per_producer = total_events / num_producers;
+    const int expected_events = events_per_producer * num_producers;
+
+    std::vector<double> latencies_us;
+    latencies_us.reserve(expected_events);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread consumer([&] {
+        for (int i = 0; i < expected_events; ++i) {
+            Event event = queue.pop();
+            auto latency = std::chrono::system_clock::now() - event.timestamp;
+            latencies_us.push_back(std::chrono::duration<double, std::micro>(latency).count());
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < events_per_producer; ++i) {
+                Event event;
+                event.type = "benchmark";
+                event.source = "producer";
+                event.data["seq"] = i;
+                event.data["producer"] = p;
+                event.timestamp = std::chrono::system_clock::now();
+                queue.push(std::move(event));
+            }
+        });
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+    consumer.join();
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    auto percentile = [&](double p) {
+        return latencies_us[static_cast<size_t>(p * (latencies_us.size() - 1))];
+    };
+    return {expected_events / elapsed, percentile(0.50), percentile(0.99), latencies_us.back()};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int total_events = 400000;
+    if (argc > 1) {
+        total_events = std::max(16, std::atoi(argv[1]));
+    }
+
+    std::printf("EventQueue benchmark: %d events per run, 1 consumer (blocking pop)\n\n", total_events);
+    std::printf("%-9s %9s %14s %10s %10s %12s\n", "backend", "producers", "events/s", "p50 (us)", "p99 (us)", "max (us)");
+
+    for (int producers : {1, 4, 16}) {
+        for (auto backend : {EventQueue::Backend::Mutex, EventQueue::Backend::LockFree}) {
+            BenchmarkResult r = runBenchmark(backend, producers, total_events);
+            std::printf("%-9s %9d %14.0f %10.1f %10.1f %12.1f\n",
+                        backendName(backend), producers, r.events_per_sec, r.p50_us, r.p99_us, r.max_us);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+// benchmarks/RuleEngineBenchmark.cpp
+// RuleEngine throughput at 1, 2, 4 and 8 workers.
+//
+// Events come from 64 sources and are partitioned by source. Each worker evaluates its batches
+// against one lock-free RuleSet snapshot; the rules are chosen so that nothing matches, which keeps
+// logging and action dispatch out of the measurement.
+#include "core/RuleEngine.h"
+#include "rules/RuleParser.h"
+#include "rules/RuleSet.h"
+
+#include <algorithm> // For std::max
+#include <chrono>    // For timing
+#include <cstdlib>   // For std::atoi
+#include <cstdio>    // For std::printf
+#include <string>
+#include <vector>
+
+namespace {
+
+std::shared_ptr<const RuleSet> makeRuleSet(int count) {
+    std::vector<Rule> rules;
+    for (int i = 0; i < count; ++i) {
+        nlohmann::json rule_json = {
+            {"id", "rule_" + std::to_string(i)},
+            {"condition", {{"and", {
+                {{"key", "temperature"}, {"operator", ">"}, {"value", 1000 + i}},
+                {{"key", "humidity"}, {"operator", "<"}, {"value", -1.0 - i}}
+            }}}},
+            {"actions", nlohmann::json::array()}
+        };
+        rules.push_back(std::move(*RuleParser::parse(rule_json)));
+    }
+    return RuleSet::build(std::move(rules), false);
+}
+
+Event makeEvent(int i) {
+    Event event;
+    event.source = "sensor_" + std::to_string(i % 64);
+    event.data["temperature"] = 15 + i % 30;
+    event.data["humidity"] = 40.5 + i % 20;
+    return event;
+}
+
+// @return Events per second through the engine with the given number of workers.
+double measure(const std::shared_ptr<const RuleSet>& ruleset, size_t workers, int event_count) {
+    EventQueue input;
+    RuleEngine::Options options;
+    options.workers = workers;
+    RuleEngine engine(input, [&ruleset](std::vector<Event>& batch, size_t) {
+        for (const auto& event : batch) {
+            ruleset->evaluate(event);
+        }
+    }, options);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < event_count; ++i) {
+        input.push(makeEvent(i));
+    }
+    engine.stop(); // Waits until every event has been evaluated
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return event_count / seconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int event_count = 200000;
+    if (argc > 1) {
+        event_count = std::max(1, std::atoi(argv[1]));
+    }
+    const auto ruleset = makeRuleSet(500);
+
+    std::printf("RuleEngine benchmark: %d events, %zu rules, 64 sources\n\n", event_count, ruleset->rules().size());
+    std::printf("%8s %16s %10s\n", "workers", "events/s", "speedup");
+    double baseline = 0.0;
+    for (size_t workers : {1, 2, 4, 8}) {
+        double rate = measure(ruleset, workers, event_count);
+        if (workers == 1) {
+            baseline = rate;
+        }
+        std::printf("%8zu %16.0f %9.2fx\n", workers, rate, rate / baseline);
+    }
+    return 0;
+}
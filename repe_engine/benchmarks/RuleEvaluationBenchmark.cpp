@@ -0,0 +1,111 @@
+// benchmarks/RuleEvaluationBenchmark.cpp
+// Per-rule evaluation cost: condition tree (virtual ICondition calls) vs compiled ConditionProgram
+// vs the shared AlphaNetwork (each distinct test evaluated once per event).
+//
+// Each rule is "temperature > T and (location == L or humidity < H)"; events carry a mix of
+// int and double readings so the cross-type int/double comparison path is exercised too.
+#include "rules/RuleParser.h"
+#include "rules/Rule.h"
+#include "rules/AlphaNetwork.h"
+
+#include <algorithm> // For std::max
+#include <chrono>    // For timing
+#include <cstdlib>   // For std::atoi
+#include <cstdio>    // For std::printf
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<Rule> makeRules(int count) {
+    std::vector<Rule> rules;
+    for (int i = 0; i < count; ++i) {
+        nlohmann::json rule_json = {
+            {"id", "rule_" + std::to_string(i)},
+            {"condition", {{"and", {
+                {{"key", "temperature"}, {"operator", ">"}, {"value", 20 + i % 20}},
+                {{"or", {
+                    {{"key", "location"}, {"operator", "=="}, {"value", "Room" + std::to_string(i % 8)}},
+                    {{"key", "humidity"}, {"operator", "<"}, {"value", 30.5 + i % 10}}
+                }}}
+            }}}},
+            {"actions", nlohmann::json::array()}
+        };
+        rules.push_back(std::move(*RuleParser::parse(rule_json)));
+    }
+    return rules;
+}
+
+std::vector<Event> makeEvents(int count) {
+    std::vector<Event> events(count);
+    for (int i = 0; i < count; ++i) {
+        if (i % 2 == 0) {
+            events[i].data["temperature"] = 15 + i % 30;          // int
+        } else {
+            events[i].data["temperature"] = 15.5 + i % 30;        // double
+        }
+        events[i].data["location"] = "Room" + std::to_string(i % 10);
+        events[i].data["humidity"] = 25 + i % 20;
+    }
+    return events;
+}
+
+// @return Nanoseconds per (event, rule) evaluation and the number of matches (to keep the work observable).
+template <typename Evaluate>
+std::pair<double, long> measure(const std::vector<Rule>& rules, const std::vector<Event>& events,
+                                int rounds, Evaluate evaluate) {
+    long matches = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& event : events) {
+            for (const auto& rule : rules) {
+                matches += evaluate(rule, event) ? 1 : 0;
+            }
+        }
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return {elapsed / (static_cast<double>(rounds) * events.size() * rules.size()), matches};
+}
+
+// Same measurement for the alpha network, which matches all rules against an event at once.
+std::pair<double, long> measureNetwork(const std::vector<Rule>& rules, const std::vector<Event>& events, int rounds) {
+    AlphaNetwork network(rules);
+    std::vector<size_t> matched;
+    long matches = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& event : events) {
+            matched.clear();
+            network.match(rules, event, matched);
+            matches += static_cast<long>(matched.size());
+        }
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return {elapsed / (static_cast<double>(rounds) * events.size() * rules.size()), matches};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int rounds = 20;
+    if (argc > 1) {
+        rounds = std::max(1, std::atoi(argv[1]));
+    }
+    const std::vector<Event> events = makeEvents(1000);
+
+    std::printf("Rule evaluation benchmark: %zu events x %d rounds\n\n", events.size(), rounds);
+    std::printf("%6s %16s %16s %16s %10s\n", "rules", "tree (ns/rule)", "program (ns/rule)", "alpha (ns/rule)", "matches");
+
+    for (int rule_count : {10, 100, 1000}) {
+        auto rules = makeRules(rule_count);
+        auto tree = measure(rules, events, rounds, [](const Rule& rule, const Event& event) {
+            return rule.getCondition()->evaluate(event);
+        });
+        auto program = measure(rules, events, rounds, [](const Rule& rule, const Event& event) {
+            return rule.getProgram()->run(event);
+        });
+        auto alpha = measureNetwork(rules, events, rounds);
+        std::printf("%6d %16.1f %16.1f %16.1f %10ld\n", rule_count, tree.first, program.first, alpha.first, alpha.second);
+    }
+    return 0;
+}
@@ -1,31 +1,37 @@
 // common/Event.h
 #pragma once
 
+#include "common/EventData.h" // EventValue và EventData (key đã intern, lưu phẳng inline)
 #include <string>
-#include <map>
-#include <variant>     // C++17 feature for std::variant
 #include <chrono>      // For timestamp
 #include <iostream>    // For debugging dump
 #include <atomic>      // For generateUniqueId
+#include <cstdint>     // For EventId
 #include <iomanip>     // For std::put_time
+#include <memory>      // For EventRef
 
-// Định nghĩa một kiểu alias cho các giá trị có thể có trong Event
-// EventValue có thể chứa int, double, bool, hoặc std::string
-using EventValue = std::variant<int, double, bool, std::string>;
+// ID số 64-bit của Event. 0 nghĩa là chưa được gán ID.
+// Chỉ được chuyển thành chuỗi (formatEventId) khi log hoặc action thật sự cần.
+using EventId = uint64_t;
+
+// Hàm tiện ích để hiển thị ID của Event dưới dạng chuỗi (e.g., "evt_42").
+inline std::string formatEventId(EventId id) {
+    return "evt_" + std::to_string(id);
+}
 
 // Định nghĩa cấu trúc Event
 struct Event {
-    std::string id; // ID duy nhất cho sự kiện, có thể là UUID
+    EventId id = 0; // ID duy nhất cho sự kiện (xem generateUniqueId)
     std::string type; // Loại sự kiện (e.g., "sensor_reading", "user_login", "system_alert")
     std::string source; // Tên nguồn (e.g., "mqtt/temp_sensor_01", "http_api/dashboard")
     std::chrono::time_point<std::chrono::system_clock> timestamp; // Thời gian sự kiện xảy ra
 
-    // Dữ liệu cụ thể của sự kiện dưới dạng key-value map
-    std::map<std::string, EventValue> data;
+    // Dữ liệu cụ thể của sự kiện dưới dạng key-value (key là KeyId đã intern, xem EventData.h)
+    EventData data;
 
     // Hàm để dễ dàng debug hoặc log Event
     std::string toString() const {
-        std::string s = "Event ID: " + id + "\n";
+        std::string s = "Event ID: " + formatEventId(id) + "\n";
         s += "  Type: " + type + "\n";
         s += "  Source: " + source + "\n";
 
@@ -38,28 +44,37 @@ struct Event {
 
         s += "  Data:\n";
         for (const auto& pair : data) {
-            s += "    " + pair.first + ": ";
-            std::visit([&](auto&& arg) {
-                // Sử dụng if constexpr (C++17) để xử lý các kiểu khác nhau trong variant
-                if constexpr (std::is_same_v<decltype(arg), int>) {
-                    s += std::to_string(arg);
-                } else if constexpr (std::is_same_v<decltype(arg), double>) {
-                    s += std::to_string(arg);
-                } else if constexpr (std::is_same_v<decltype(arg), bool>) {
-                    s += (arg ? "true" : "false");
-                } else if constexpr (std::is_same_v<decltype(arg), std::string>) {
-                    s += "\"" + arg + "\"";
-                }
-            }, pair.second);
+            s += "    " + KeyRegistry::name(pair.first) + ": ";
+            if (std::holds_alternative<std::string>(pair.second)) {
+                s += "\"" + std::get<std::string>(pair.second) + "\"";
+            } else {
+                s += eventValueToString(pair.second);
+            }
             s += "\n";
         }
         return s;
     }
 };
 
+// EventRef là ảnh chụp bất biến, đếm tham chiếu của một Event đã khớp quy tắc.
+// Mọi hành động do Event đó kích hoạt dùng chung một EventRef thay vì mỗi hành động một bản sao,
+// và Event sống cho đến khi hành động bất đồng bộ cuối cùng chạy xong (xem EventPool::share).
+using EventRef = std::shared_ptr<const Event>;
+
+// Số ID mỗi luồng lấy về một lần từ bộ đếm toàn cục.
+inline constexpr EventId kEventIdBlockSize = 1024;
+
 // Hàm tiện ích để sinh ID duy nhất cho sự kiện
-// Trong môi trường thực tế, nên dùng thư viện UUID (ví dụ Boost.UUID)
-inline std::string generateUniqueId() {
-    static std::atomic<long long> counter = 0;
-    return "evt_" + std::to_string(counter++);
+// Mỗi luồng lấy một khối kEventIdBlockSize ID từ bộ đếm toàn cục rồi cấp dần trong khối,
+// nên thao tác atomic dùng chung chỉ xảy ra một lần cho mỗi khối thay vì mỗi Event.
+// ID là duy nhất nhưng không tăng dần theo thời gian giữa các luồng khác nhau.
+inline EventId generateUniqueId() {
+    static std::atomic<EventId> next_block{1}; // ID 0 được dành cho "chưa gán"
+    thread_local EventId next = 0;
+    thread_local EventId block_end = 0;
+    if (next == block_end) {
+        next = next_block.fetch_add(kEventIdBlockSize, std::memory_order_relaxed);
+        block_end = next + kEventIdBlockSize;
+    }
+    return next++;
 }
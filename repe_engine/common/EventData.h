@@ -0,0 +1,243 @@
+// common/EventData.h
+#pragma once
+
+#include "common/KeyRegistry.h" // KeyId và bảng intern key
+#include <string>
+#include <string_view>
+#include <variant>     // C++17 feature for std::variant
+#include <array>       // Bộ nhớ inline
+#include <vector>      // Bộ nhớ heap khi vượt quá dung lượng inline
+#include <utility>     // Cho std::pair, std::move
+#include <algorithm>   // Cho std::lower_bound, std::move_backward
+#include <cstdint>
+#include <type_traits> // Cho std::decay_t trong eventValueToString
+
+// EventBlob là một khối byte nhị phân (e.g., payload thô từ cảm biến, dữ liệu CBOR/MessagePack).
+// Được bọc trong struct để phân biệt với mảng số.
+struct EventBlob {
+    std::vector<uint8_t> bytes;
+
+    bool operator==(const EventBlob& other) const { return bytes == other.bytes; }
+    bool operator!=(const EventBlob& other) const { return bytes != other.bytes; }
+};
+
+// Mảng số thuần nhất, lưu liên tục trong bộ nhớ (e.g., chuỗi mẫu đo của cảm biến).
+using EventIntArray = std::vector<int64_t>;
+using EventDoubleArray = std::vector<double>;
+
+// Định nghĩa một kiểu alias cho các giá trị có thể có trong Event
+// EventValue có thể chứa int, double, bool, std::string, số nguyên 64-bit (có dấu / không dấu),
+// khối byte nhị phân, hoặc mảng số thuần nhất.
+// int được giữ ở vị trí đầu tiên để giá trị mặc định vẫn là int 0; số nguyên vừa với int
+// vẫn được lưu dưới dạng int, int64_t/uint64_t chỉ dùng cho giá trị vượt phạm vi của int.
+using EventValue = std::variant<int, double, bool, std::string,
+                                int64_t, uint64_t, EventBlob, EventIntArray, EventDoubleArray>;
+
+// Hàm tiện ích chuyển EventValue thành chuỗi để log hoặc điền vào template của action.
+// Mảng được hiển thị dạng [1, 2, 3]; blob chỉ hiển thị kích thước.
+inline std::string eventValueToString(const EventValue& value) {
+    return std::visit([](const auto& arg) -> std::string {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            return arg ? "true" : "false";
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return arg;
+        } else if constexpr (std::is_same_v<T, EventBlob>) {
+            return "<blob " + std::to_string(arg.bytes.size()) + " bytes>";
+        } else if constexpr (std::is_same_v<T, EventIntArray> || std::is_same_v<T, EventDoubleArray>) {
+            std::string s = "[";
+            for (size_t i = 0; i < arg.size(); ++i) {
+                if (i > 0) {
+                    s += ", ";
+                }
+                s += std::to_string(arg[i]);
+            }
+            return s + "]";
+        } else {
+            return std::to_string(arg); // int, double, int64_t, uint64_t
+        }
+    }, value);
+}
+
+// EventData là dữ liệu key-value của một Event, thay cho std::map<std::string, EventValue>.
+// Các cặp (KeyId, EventValue) được lưu trong một mảng phẳng, sắp xếp theo KeyId:
+// - Tối đa kInlineCapacity trường được lưu ngay trong đối tượng, không cấp phát heap cho mỗi trường.
+// - Vượt quá số đó, toàn bộ dữ liệu được chuyển sang một std::vector.
+// Tra cứu theo KeyId là tìm kiếm nhị phân trên số nguyên. Tra cứu theo tên chỉ dùng
+// KeyRegistry::lookup, không thêm key mới vào bảng intern.
+class EventData {
+public:
+    // Số trường được lưu inline, đủ cho các Event điển hình (4-8 trường).
+    static constexpr size_t kInlineCapacity = 8;
+
+    using value_type = std::pair<KeyId, EventValue>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    EventData() = default;
+
+    EventData(const EventData& other) { assign(other.begin(), other.end()); }
+    EventData& operator=(const EventData& other) {
+        if (this != &other) {
+            clear();
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    EventData(EventData&& other) noexcept { takeFrom(other); }
+    EventData& operator=(EventData&& other) noexcept {
+        if (this != &other) {
+            clear();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    // operator[]: Truy cập (hoặc tạo mới với giá trị mặc định) trường theo KeyId.
+    EventValue& operator[](KeyId key) {
+        value_type* pos = lowerBound(key);
+        if (pos != end() && pos->first == key) {
+            return pos->second;
+        }
+        return insertAt(pos, key)->second;
+    }
+
+    // operator[]: Truy cập (hoặc tạo mới) trường theo tên; tên được intern vào KeyRegistry.
+    EventValue& operator[](std::string_view name) {
+        return (*this)[KeyRegistry::intern(name)];
+    }
+
+    // Phương thức get: Con trỏ tới giá trị của trường, hoặc nullptr nếu Event không có trường đó.
+    // Đây là hàm tra cứu trên đường nóng của rule engine.
+    const EventValue* get(KeyId key) const {
+        const value_type* pos = lowerBound(key);
+        return (pos != end() && pos->first == key) ? &pos->second : nullptr;
+    }
+
+    const EventValue* get(std::string_view name) const {
+        auto key = KeyRegistry::lookup(name);
+        return key ? get(*key) : nullptr;
+    }
+
+    // Phương thức find: Giống std::map::find, trả về end() nếu không tìm thấy.
+    iterator find(KeyId key) {
+        value_type* pos = lowerBound(key);
+        return (pos != end() && pos->first == key) ? pos : end();
+    }
+    const_iterator find(KeyId key) const {
+        const value_type* pos = lowerBound(key);
+        return (pos != end() && pos->first == key) ? pos : end();
+    }
+    iterator find(std::string_view name) {
+        auto key = KeyRegistry::lookup(name);
+        return key ? find(*key) : end();
+    }
+    const_iterator find(std::string_view name) const {
+        auto key = KeyRegistry::lookup(name);
+        return key ? find(*key) : end();
+    }
+
+    bool contains(KeyId key) const { return get(key) != nullptr; }
+    bool contains(std::string_view name) const { return get(name) != nullptr; }
+
+    // Phương thức erase: Xóa một trường, trả về true nếu trường tồn tại.
+    bool erase(KeyId key) {
+        value_type* pos = find(key);
+        if (pos == end()) {
+            return false;
+        }
+        std::move(pos + 1, end(), pos);
+        --size_;
+        if (on_heap_) {
+            heap_.pop_back();
+        } else {
+            inline_[size_].second = EventValue{}; // Giải phóng chuỗi (nếu có) ngay
+        }
+        return true;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < size_ && !on_heap_; ++i) {
+            inline_[i].second = EventValue{};
+        }
+        heap_.clear();
+        on_heap_ = false;
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // isInline: true nếu dữ liệu đang nằm trong bộ nhớ inline (không có cấp phát heap).
+    bool isInline() const { return !on_heap_; }
+
+    iterator begin() { return storage(); }
+    iterator end() { return storage() + size_; }
+    const_iterator begin() const { return storage(); }
+    const_iterator end() const { return storage() + size_; }
+
+private:
+    value_type* storage() { return on_heap_ ? heap_.data() : inline_.data(); }
+    const value_type* storage() const { return on_heap_ ? heap_.data() : inline_.data(); }
+
+    value_type* lowerBound(KeyId key) {
+        return std::lower_bound(begin(), end(), key,
+                                [](const value_type& entry, KeyId k) { return entry.first < k; });
+    }
+    const value_type* lowerBound(KeyId key) const {
+        return std::lower_bound(begin(), end(), key,
+                                [](const value_type& entry, KeyId k) { return entry.first < k; });
+    }
+
+    // Chèn một trường mới (giá trị mặc định) tại vị trí pos, giữ thứ tự theo KeyId.
+    value_type* insertAt(value_type* pos, KeyId key) {
+        size_t index = static_cast<size_t>(pos - begin());
+        if (!on_heap_ && size_ == kInlineCapacity) {
+            // Hết chỗ inline: chuyển toàn bộ sang heap.
+            heap_.reserve(kInlineCapacity * 2);
+            for (size_t i = 0; i < size_; ++i) {
+                heap_.push_back(std::move(inline_[i]));
+                inline_[i].second = EventValue{};
+            }
+            on_heap_ = true;
+        }
+        if (on_heap_) {
+            heap_.emplace(heap_.begin() + static_cast<std::ptrdiff_t>(index), key, EventValue{});
+        } else {
+            std::move_backward(inline_.begin() + index, inline_.begin() + size_, inline_.begin() + size_ + 1);
+            inline_[index] = value_type(key, EventValue{});
+        }
+        ++size_;
+        return begin() + index;
+    }
+
+    // Sao chép các trường (đã sắp xếp) từ một EventData khác.
+    void assign(const_iterator first, const_iterator last) {
+        size_t count = static_cast<size_t>(last - first);
+        if (count > kInlineCapacity) {
+            heap_.assign(first, last);
+            on_heap_ = true;
+        } else {
+            std::copy(first, last, inline_.begin());
+        }
+        size_ = count;
+    }
+
+    // Lấy dữ liệu từ other (move) và để other ở trạng thái rỗng.
+    void takeFrom(EventData& other) {
+        if (other.on_heap_) {
+            heap_ = std::move(other.heap_);
+            on_heap_ = true;
+        } else {
+            std::move(other.inline_.begin(), other.inline_.begin() + other.size_, inline_.begin());
+        }
+        size_ = other.size_;
+        other.clear();
+    }
+
+    std::array<value_type, kInlineCapacity> inline_{}; // Bộ nhớ inline
+    std::vector<value_type> heap_;                      // Chỉ dùng khi số trường vượt kInlineCapacity
+    uint32_t size_ = 0;
+    bool on_heap_ = false;
+};
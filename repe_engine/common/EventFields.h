@@ -0,0 +1,102 @@
+// common/EventFields.h
+#pragma once
+
+#include "common/EventData.h"      // EventValue, KeyId
+#include "common/EventValueJson.h" // eventValueFromInteger/eventValueFromUnsigned
+#include "common/KeyRegistry.h"
+#include <array>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>     // Cho std::index_sequence
+
+// Mô tả trường lúc biên dịch để ánh xạ thẳng một struct vào Event::data,
+// không đi vòng qua nlohmann::json (to_json rồi duyệt lại JSON).
+//
+// Đăng ký một struct (ở namespace toàn cục, sau định nghĩa struct):
+//     struct SensorReading { double temperature; int humidity; std::string location; };
+//     REPE_EVENT_FIELDS(SensorReading,
+//         REPE_EVENT_FIELD(SensorReading, temperature),
+//         REPE_EVENT_FIELD(SensorReading, humidity),
+//         REPE_EVENT_FIELD(SensorReading, location));
+//
+// EventProcessor::processStructuredData dùng mô tả này khi có; struct chưa đăng ký vẫn đi
+// theo đường to_json như trước. Giá trị được chuyển giống đường JSON (số nguyên vừa int vẫn là int,
+// float thành double, ...), nên rule không phân biệt được Event đến từ đường nào.
+
+// Một trường: tên key và con trỏ tới thành viên.
+template <typename T, typename M>
+struct EventField {
+    const char* name;
+    M T::* member;
+};
+
+template <typename T, typename M>
+constexpr EventField<T, M> eventField(const char* name, M T::* member) {
+    return EventField<T, M>{name, member};
+}
+
+// Trait mô tả các trường của T. Mặc định: chưa đăng ký.
+// Specialization (qua REPE_EVENT_FIELDS) cung cấp `static constexpr auto fields` là một std::tuple các EventField.
+template <typename T>
+struct EventFields {
+    static constexpr bool kRegistered = false;
+};
+
+#define REPE_EVENT_FIELD(Type, member) ::eventField(#member, &Type::member)
+
+#define REPE_EVENT_FIELDS(Type, ...)                                   \
+    template <>                                                        \
+    struct EventFields<Type> {                                         \
+        static constexpr bool kRegistered = true;                      \
+        static constexpr auto fields = std::make_tuple(__VA_ARGS__);   \
+    }
+
+// Chuyển giá trị của một thành viên thành EventValue, theo cùng quy tắc với eventValueFromJson.
+template <typename M>
+EventValue toEventValue(const M& value) {
+    using V = std::decay_t<M>;
+    if constexpr (std::is_same_v<V, bool>) {
+        return EventValue(value);
+    } else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+        return eventValueFromInteger(static_cast<int64_t>(value));
+    } else if constexpr (std::is_integral_v<V>) {
+        return eventValueFromUnsigned(static_cast<uint64_t>(value));
+    } else if constexpr (std::is_floating_point_v<V>) {
+        return EventValue(static_cast<double>(value));
+    } else if constexpr (std::is_convertible_v<const V&, std::string_view>) {
+        return EventValue(std::string(std::string_view(value)));
+    } else {
+        static_assert(std::is_constructible_v<EventValue, const V&>,
+                      "Struct member type cannot be stored in an EventValue");
+        return EventValue(value);
+    }
+}
+
+namespace event_fields_detail {
+
+template <typename Fields, size_t... I>
+std::array<KeyId, sizeof...(I)> internKeys(const Fields& fields, std::index_sequence<I...>) {
+    return {KeyRegistry::intern(std::get<I>(fields).name)...};
+}
+
+template <typename T, typename Fields, size_t... I>
+void store(EventData& data, const T& value, const std::array<KeyId, sizeof...(I)>& keys,
+           const Fields& fields, std::index_sequence<I...>) {
+    (void(data[keys[I]] = toEventValue(value.*(std::get<I>(fields).member))), ...);
+}
+
+} // namespace event_fields_detail
+
+// Hàm storeEventFields: Ghi mọi trường đã đăng ký của value vào data.
+// Tên key chỉ được intern một lần cho mỗi kiểu T; sau đó mỗi trường chỉ là một lần ghi theo KeyId.
+template <typename T>
+void storeEventFields(EventData& data, const T& value) {
+    static_assert(EventFields<T>::kRegistered, "Type is not registered with REPE_EVENT_FIELDS");
+    constexpr auto& fields = EventFields<T>::fields;
+    constexpr size_t kCount = std::tuple_size_v<std::decay_t<decltype(fields)>>;
+    static const std::array<KeyId, kCount> keys =
+        event_fields_detail::internKeys(fields, std::make_index_sequence<kCount>{});
+    event_fields_detail::store(data, value, keys, fields, std::make_index_sequence<kCount>{});
+}
@@ -0,0 +1,109 @@
+// common/EventValueJson.h
+#pragma once
+
+#include "common/EventData.h" // EventValue, EventBlob, mảng số
+#include <nlohmann/json.hpp>
+#include <limits>      // Cho std::numeric_limits
+#include <optional>    // C++17 feature for std::optional
+#include <string>
+#include <type_traits>
+
+// Chuyển đổi giữa nlohmann::json và EventValue, dùng chung cho EventProcessor (dữ liệu đầu vào),
+// RuleParser (giá trị trong điều kiện) và HttpAction (payload đầu ra).
+
+// Số nguyên từ JSON: int nếu vừa, nếu không thì int64_t (không bị cắt về int).
+inline EventValue eventValueFromInteger(int64_t i) {
+    if (i >= std::numeric_limits<int>::min() && i <= std::numeric_limits<int>::max()) {
+        return EventValue(static_cast<int>(i));
+    }
+    return EventValue(i);
+}
+
+// Số nguyên không dấu từ JSON: int nếu vừa, sau đó int64_t, cuối cùng uint64_t.
+inline EventValue eventValueFromUnsigned(uint64_t u) {
+    if (u <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+        return eventValueFromInteger(static_cast<int64_t>(u));
+    }
+    return EventValue(u);
+}
+
+// Phương thức eventValueFromJson: Chuyển một giá trị JSON thành EventValue mà không làm mất thông tin.
+// - Số nguyên: int nếu vừa, nếu không thì int64_t hoặc uint64_t (không bị cắt về int).
+// - Số thực: double. bool, string: giữ nguyên.
+// - Mảng số thuần nhất: EventIntArray nếu mọi phần tử là số nguyên vừa int64_t, EventDoubleArray
+//   nếu có số thực. Mảng rỗng được coi là EventIntArray.
+// - JSON binary (từ CBOR/MessagePack/BSON): EventBlob.
+// @return EventValue, hoặc std::nullopt với object, null và mảng không thuần nhất
+//         (caller tự quyết định xử lý, e.g., lưu dạng chuỗi JSON).
+inline std::optional<EventValue> eventValueFromJson(const nlohmann::json& j) {
+    switch (j.type()) {
+    case nlohmann::json::value_t::number_unsigned:
+        return eventValueFromUnsigned(j.get<uint64_t>());
+    case nlohmann::json::value_t::number_integer:
+        return eventValueFromInteger(j.get<int64_t>());
+    case nlohmann::json::value_t::number_float:
+        return EventValue(j.get<double>());
+    case nlohmann::json::value_t::boolean:
+        return EventValue(j.get<bool>());
+    case nlohmann::json::value_t::string:
+        return EventValue(j.get<std::string>());
+    case nlohmann::json::value_t::binary:
+        return EventValue(EventBlob{j.get_binary()});
+    case nlohmann::json::value_t::array: {
+        bool all_integers = true;
+        for (const auto& element : j) {
+            if (!element.is_number()) {
+                return std::nullopt; // Mảng không thuần nhất hoặc mảng lồng nhau
+            }
+            if (element.is_number_float() ||
+                (element.is_number_unsigned() &&
+                 element.get<uint64_t>() > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))) {
+                all_integers = false;
+            }
+        }
+        if (all_integers) {
+            EventIntArray values;
+            values.reserve(j.size());
+            for (const auto& element : j) {
+                values.push_back(element.get<int64_t>());
+            }
+            return EventValue(std::move(values));
+        }
+        EventDoubleArray values;
+        values.reserve(j.size());
+        for (const auto& element : j) {
+            values.push_back(element.get<double>());
+        }
+        return EventValue(std::move(values));
+    }
+    default:
+        return std::nullopt; // object, null, discarded
+    }
+}
+
+// Phương thức eventValueToJson: Chuyển EventValue thành giá trị JSON.
+// Mảng số thành mảng JSON; EventBlob thành chuỗi base64 (JSON văn bản không có kiểu nhị phân).
+inline nlohmann::json eventValueToJson(const EventValue& value) {
+    return std::visit([](const auto& arg) -> nlohmann::json {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, EventBlob>) {
+            static constexpr char kAlphabet[] =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            const auto& bytes = arg.bytes;
+            std::string encoded;
+            encoded.reserve((bytes.size() + 2) / 3 * 4);
+            for (size_t i = 0; i < bytes.size(); i += 3) {
+                uint32_t chunk = static_cast<uint32_t>(bytes[i]) << 16;
+                if (i + 1 < bytes.size()) chunk |= static_cast<uint32_t>(bytes[i + 1]) << 8;
+                if (i + 2 < bytes.size()) chunk |= static_cast<uint32_t>(bytes[i + 2]);
+                encoded += kAlphabet[(chunk >> 18) & 0x3F];
+                encoded += kAlphabet[(chunk >> 12) & 0x3F];
+                encoded += i + 1 < bytes.size() ? kAlphabet[(chunk >> 6) & 0x3F] : '=';
+                encoded += i + 2 < bytes.size() ? kAlphabet[chunk & 0x3F] : '=';
+            }
+            return encoded;
+        } else {
+            return arg; // Số, bool, chuỗi và std::vector số được nlohmann::json hỗ trợ trực tiếp
+        }
+    }, value);
+}
@@ -0,0 +1,104 @@
+// common/IngestFilter.h
+#pragma once
+
+#include "common/Event.h"
+#include "common/KeyRegistry.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm> // Cho std::binary_search
+
+// IngestFilter là bản tóm tắt của bộ quy tắc đã tải, dùng để loại Event ngay tại EventProcessor
+// (trước khi vào EventQueue) khi chắc chắn không quy tắc nào có thể khớp với nó.
+//
+// Mỗi quy tắc được tóm tắt thành một Scope:
+// - event_types:     Event::type mà quy tắc chấp nhận (rỗng = mọi type).
+// - source_prefixes: Tiền tố Event::source mà quy tắc chấp nhận (rỗng = mọi nguồn).
+// - keys:            Quy tắc chỉ có thể khớp nếu Event có ít nhất một trong các key này
+//                    (any_key = true khi không suy ra được, e.g., điều kiện "not").
+// Event được nhận nếu có ít nhất một Scope chấp nhận nó. Bản tóm tắt luôn "an toàn":
+// nó có thể nhận Event không khớp quy tắc nào, nhưng không bao giờ loại Event có thể khớp.
+//
+// RuleManager tạo lại IngestFilter mỗi lần loadRules (xem RuleManager::subscribeIngestFilter).
+class IngestFilter {
+public:
+    struct Scope {
+        std::vector<std::string> event_types;
+        std::vector<std::string> source_prefixes;
+        bool any_key = true;
+        std::vector<KeyId> keys; // Đã sắp xếp, chỉ dùng khi any_key == false
+    };
+
+    IngestFilter() = default;
+    explicit IngestFilter(std::vector<Scope> scopes) : scopes_(std::move(scopes)) {
+        for (auto& scope : scopes_) {
+            std::sort(scope.keys.begin(), scope.keys.end());
+            scope.keys.erase(std::unique(scope.keys.begin(), scope.keys.end()), scope.keys.end());
+        }
+    }
+
+    // Phương thức acceptsSource: Có quy tắc nào có thể khớp với Event từ nguồn này không.
+    // Dùng để bỏ qua việc phân tích payload thô trước khi biết nội dung của nó.
+    bool acceptsSource(std::string_view source) const {
+        for (const auto& scope : scopes_) {
+            if (matchesSource(scope, source)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Phương thức acceptsHeader: Như acceptsSource, nhưng xét cả Event::type.
+    bool acceptsHeader(std::string_view type, std::string_view source) const {
+        for (const auto& scope : scopes_) {
+            if (matchesType(scope, type) && matchesSource(scope, source)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Phương thức accepts: Có quy tắc nào có thể khớp với Event đã được phân tích không.
+    bool accepts(const Event& event) const {
+        for (const auto& scope : scopes_) {
+            if (matchesType(scope, event.type) && matchesSource(scope, event.source) && matchesKeys(scope, event)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const std::vector<Scope>& scopes() const { return scopes_; }
+
+private:
+    static bool matchesType(const Scope& scope, std::string_view type) {
+        return scope.event_types.empty() ||
+               std::find(scope.event_types.begin(), scope.event_types.end(), type) != scope.event_types.end();
+    }
+
+    static bool matchesSource(const Scope& scope, std::string_view source) {
+        if (scope.source_prefixes.empty()) {
+            return true;
+        }
+        for (const auto& prefix : scope.source_prefixes) {
+            if (source.substr(0, prefix.size()) == prefix) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool matchesKeys(const Scope& scope, const Event& event) {
+        if (scope.any_key) {
+            return true;
+        }
+        for (const auto& entry : event.data) {
+            if (std::binary_search(scope.keys.begin(), scope.keys.end(), entry.first)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<Scope> scopes_;
+};
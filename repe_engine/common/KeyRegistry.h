@@ -0,0 +1,139 @@
+// common/KeyRegistry.h
+#pragma once
+
+#include <string>
+#include <string_view>   // C++17 for efficient string passing
+#include <deque>         // Lưu tên key, địa chỉ phần tử không đổi khi thêm mới
+#include <unordered_map> // Tra cứu tên -> id
+#include <shared_mutex>  // Nhiều luồng đọc song song, ghi độc quyền
+#include <mutex>         // Cho std::unique_lock
+#include <optional>      // C++17 feature for std::optional
+#include <atomic>        // Bộ đếm key bị từ chối khi ingest
+#include <iostream>      // Cảnh báo khi chạm giới hạn intern-on-ingest
+#include <cstdint>       // Cho uint32_t
+#include <stdexcept>     // Cho std::out_of_range
+
+// KeyId là định danh số của một key dữ liệu trong Event (e.g., "temperature" -> 3).
+using KeyId = uint32_t;
+
+// KeyRegistry là bảng intern toàn cục cho các key dữ liệu của Event.
+// Mỗi tên key chỉ được lưu một lần; Event và ValueCondition chỉ giữ KeyId,
+// nên việc tra cứu trên đường nóng là so sánh số nguyên thay vì so sánh chuỗi.
+// Id được cấp tăng dần và không bao giờ bị thu hồi trong suốt vòng đời chương trình.
+//
+// Vì bảng không bao giờ co lại, key đến từ dữ liệu đầu vào không tin cậy (JSON của các nguồn)
+// phải đi qua internFromIngest: một nguồn gửi key tùy ý hoặc luôn khác nhau chỉ làm bảng lớn
+// tới maxIngestKeys() key (mặc định kMaxIngestKeys), sau đó các key mới bị bỏ qua. Key do quy tắc hoặc mã nguồn dùng
+// được intern qua intern() và không bị giới hạn, nên quy tắc luôn thấy key mà nó tham chiếu.
+class KeyRegistry {
+public:
+    // Số key tối đa mặc định trong bảng mà internFromIngest còn được phép cấp id mới.
+    static constexpr size_t kMaxIngestKeys = 65536;
+
+    // Phương thức intern: Trả về id của key, cấp id mới nếu key chưa từng xuất hiện.
+    // @param name: Tên key.
+    // @return KeyId của key.
+    static KeyId intern(std::string_view name) {
+        Table& table = instance();
+        {
+            std::shared_lock<std::shared_mutex> lock(table.mutex);
+            auto it = table.ids.find(name);
+            if (it != table.ids.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(table.mutex);
+        return insertLocked(table, name);
+    }
+
+    // Phương thức internFromIngest: Như intern(), dùng cho key đọc từ dữ liệu đầu vào.
+    // Chỉ cấp id mới khi bảng còn ít hơn maxIngestKeys() key; key đã có vẫn luôn được trả về.
+    // @param name: Tên key lấy từ payload.
+    // @return KeyId, hoặc std::nullopt nếu key mới bị từ chối vì bảng đã chạm giới hạn.
+    static std::optional<KeyId> internFromIngest(std::string_view name) {
+        if (std::optional<KeyId> id = lookup(name)) {
+            return id;
+        }
+        Table& table = instance();
+        std::unique_lock<std::shared_mutex> lock(table.mutex);
+        const size_t limit = table.max_ingest_keys.load(std::memory_order_relaxed);
+        if (table.names.size() >= limit && table.ids.find(name) == table.ids.end()) {
+            lock.unlock();
+            if (table.rejected_ingest_keys.fetch_add(1, std::memory_order_relaxed) == 0) {
+                std::cerr << "[KeyRegistry WARNING] Key table reached " << limit
+                          << " keys; new keys from ingested data are dropped." << std::endl;
+            }
+            return std::nullopt;
+        }
+        return insertLocked(table, name);
+    }
+
+    // Phương thức lookup: Tìm id của key mà không thêm key mới vào bảng.
+    // Dùng cho các tra cứu theo tên tùy ý (e.g., placeholder trong action) để bảng không phình ra.
+    // @return KeyId, hoặc std::nullopt nếu key chưa từng được intern.
+    static std::optional<KeyId> lookup(std::string_view name) {
+        Table& table = instance();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        auto it = table.ids.find(name);
+        if (it == table.ids.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    // Phương thức size: Số key đã intern.
+    static size_t size() {
+        Table& table = instance();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        return table.names.size();
+    }
+
+    // Phương thức setMaxIngestKeys: Đổi giới hạn của internFromIngest (key đã intern được giữ nguyên).
+    static void setMaxIngestKeys(size_t limit) {
+        instance().max_ingest_keys.store(limit, std::memory_order_relaxed);
+    }
+
+    static size_t maxIngestKeys() {
+        return instance().max_ingest_keys.load(std::memory_order_relaxed);
+    }
+
+    // Phương thức rejectedIngestKeys: Số lần internFromIngest từ chối một key mới (dùng cho metric).
+    static uint64_t rejectedIngestKeys() {
+        return instance().rejected_ingest_keys.load(std::memory_order_relaxed);
+    }
+
+    // Phương thức name: Tên của một key đã intern.
+    // Tham chiếu trả về luôn hợp lệ vì tên key không bao giờ bị xóa.
+    // @throws std::out_of_range nếu id không tồn tại.
+    static const std::string& name(KeyId id) {
+        Table& table = instance();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        return table.names.at(id);
+    }
+
+private:
+    struct Table {
+        std::shared_mutex mutex;
+        std::deque<std::string> names;                     // id -> tên
+        std::unordered_map<std::string_view, KeyId> ids;   // tên -> id (view trỏ vào names)
+        std::atomic<size_t> max_ingest_keys{kMaxIngestKeys}; // Giới hạn của internFromIngest
+        std::atomic<uint64_t> rejected_ingest_keys{0};     // Xem internFromIngest
+    };
+
+    // Trả về id của key, thêm key nếu chưa có (caller đang giữ khóa ghi).
+    static KeyId insertLocked(Table& table, std::string_view name) {
+        auto it = table.ids.find(name); // Luồng khác có thể đã thêm trong lúc chờ khóa ghi
+        if (it != table.ids.end()) {
+            return it->second;
+        }
+        KeyId id = static_cast<KeyId>(table.names.size());
+        const std::string& stored = table.names.emplace_back(name);
+        table.ids.emplace(std::string_view(stored), id);
+        return id;
+    }
+
+    static Table& instance() {
+        static Table table; // Khởi tạo an toàn luồng (C++11 magic statics)
+        return table;
+    }
+};
@@ -0,0 +1,319 @@
+// core/EventJsonSax.h
+#pragma once
+
+#include "common/Event.h"
+#include "common/EventValueJson.h" // eventValueFromInteger/eventValueFromUnsigned
+#include <nlohmann/json.hpp>
+#include <iostream>    // Cho cảnh báo khi lưu giá trị dạng chuỗi JSON
+#include <string>
+#include <string_view>
+#include <vector>
+#include <limits>
+#include <optional>
+
+// EventJsonSax là SAX handler của nlohmann::json (xem nlohmann::json_sax) ghi các trường của
+// một JSON object thẳng vào Event trong một lần duyệt, không dựng DOM trung gian.
+//
+// Quy tắc ánh xạ giống với cách EventProcessor xử lý DOM trước đây:
+// - JSON ở cấp cao nhất phải là object.
+// - "type" (phải là chuỗi) được ghi vào Event::type; nếu thiếu thì dùng kDefaultEventType.
+// - "_source_id" và "_timestamp" bị bỏ qua.
+// - Số, bool, chuỗi và binary được chuyển như eventValueFromJson; mảng số thuần nhất được gom
+//   trực tiếp vào EventIntArray/EventDoubleArray.
+// - Chỉ object lồng nhau và mảng không thuần nhất mới cần dựng một cây JSON nhỏ cho riêng
+//   giá trị đó để lưu dưới dạng chuỗi JSON.
+//
+// Cách dùng:
+//     EventJsonSax sax(event);
+//     if (!nlohmann::json::sax_parse(text.begin(), text.end(), &sax)) { log(sax.error()); }
+class EventJsonSax {
+public:
+    using json = nlohmann::json;
+
+    // Event::type mặc định khi JSON không có trường "type".
+    static constexpr const char* kDefaultEventType = "generic_json_event";
+
+    // Constructor: Event nhận dữ liệu (id, source, timestamp do caller đặt).
+    explicit EventJsonSax(Event& event) : event_(event) {}
+
+    // Thông báo lỗi khi sax_parse trả về false.
+    const std::string& error() const { return error_; }
+
+    // ---------------------------------------------------------------------
+    // Giao diện SAX của nlohmann::json
+    // ---------------------------------------------------------------------
+
+    bool null() {
+        return value(json(nullptr), nullptr);
+    }
+
+    bool boolean(bool val) {
+        return value(json(val), EventValue(val));
+    }
+
+    bool number_integer(json::number_integer_t val) {
+        if (collecting_numbers_) {
+            addNumber(val);
+            return true;
+        }
+        return value(json(val), eventValueFromInteger(val));
+    }
+
+    bool number_unsigned(json::number_unsigned_t val) {
+        if (collecting_numbers_) {
+            addNumber(val);
+            return true;
+        }
+        return value(json(val), eventValueFromUnsigned(val));
+    }
+
+    bool number_float(json::number_float_t val, const json::string_t& /*raw*/) {
+        if (collecting_numbers_) {
+            addNumber(val);
+            return true;
+        }
+        return value(json(val), EventValue(val));
+    }
+
+    bool string(json::string_t& val) {
+        if (depth_ == 1) {
+            return storeField(EventValue(std::move(val))); // Chuỗi được move, không sao chép
+        }
+        return value(json(std::move(val)), nullptr);
+    }
+
+    bool binary(json::binary_t& val) {
+        if (depth_ == 1) {
+            return storeField(EventValue(EventBlob{std::move(static_cast<std::vector<uint8_t>&>(val))}));
+        }
+        return value(json::binary(val), nullptr);
+    }
+
+    bool start_object(std::size_t /*elements*/) {
+        if (depth_ == 0) {
+            depth_ = 1; // Object cấp cao nhất: các trường của Event
+            return true;
+        }
+        ++depth_;
+        return openNested(json::object());
+    }
+
+    bool key(json::string_t& val) {
+        if (depth_ == 1) {
+            field_key_.swap(val); // Tái sử dụng bộ nhớ của key trước
+        } else {
+            nested_key_.swap(val);
+        }
+        return true;
+    }
+
+    bool end_object() {
+        --depth_;
+        if (depth_ == 0) {
+            if (!type_seen_) {
+                event_.type.assign(kDefaultEventType);
+            }
+            return true;
+        }
+        return closeNested();
+    }
+
+    bool start_array(std::size_t /*elements*/) {
+        if (depth_ == 0) {
+            return fail("top-level JSON value must be an object");
+        }
+        ++depth_;
+        if (depth_ == 2) {
+            // Mảng là giá trị của một trường: thử gom thành mảng số thuần nhất.
+            collecting_numbers_ = true;
+            has_float_ = false;
+            ints_.clear();
+            doubles_.clear();
+            return true;
+        }
+        return openNested(json::array());
+    }
+
+    bool end_array() {
+        --depth_;
+        if (collecting_numbers_) {
+            collecting_numbers_ = false;
+            if (has_float_) {
+                return storeField(EventValue(std::move(doubles_)));
+            }
+            return storeField(EventValue(std::move(ints_)));
+        }
+        return closeNested();
+    }
+
+    bool parse_error(std::size_t /*position*/, const std::string& /*last_token*/, const nlohmann::detail::exception& ex) {
+        return fail(ex.what());
+    }
+
+private:
+    // Xử lý một giá trị vô hướng.
+    // @param as_json: Giá trị dưới dạng JSON (dùng khi nằm trong object/mảng lồng nhau).
+    // @param as_event_value: Giá trị dưới dạng EventValue, hoặc nullptr nếu không chuyển được.
+    template <typename EventValueOrNull>
+    bool value(json as_json, EventValueOrNull&& as_event_value) {
+        if (depth_ == 0) {
+            return fail("top-level JSON value must be an object");
+        }
+        if (depth_ == 1) {
+            if constexpr (std::is_same_v<std::decay_t<EventValueOrNull>, std::nullptr_t>) {
+                return storeStringified(as_json); // null: giữ hành vi cũ là lưu chuỗi "null"
+            } else {
+                return storeField(std::forward<EventValueOrNull>(as_event_value));
+            }
+        }
+        if (collecting_numbers_) {
+            switchToNested(); // Phần tử không phải số: mảng không thuần nhất
+        }
+        addNested(std::move(as_json));
+        return true;
+    }
+
+    // Ghi một trường cấp cao nhất vào Event.
+    bool storeField(EventValue&& val) {
+        if (field_key_ == "type") {
+            if (!std::holds_alternative<std::string>(val)) {
+                return fail("field 'type' must be a string");
+            }
+            event_.type.assign(std::get<std::string>(val));
+            type_seen_ = true;
+            return true;
+        }
+        if (isMetaKey(field_key_)) {
+            return true;
+        }
+        // Key của payload không tin cậy: không làm bảng intern phình ra vô hạn (xem KeyRegistry)
+        if (std::optional<KeyId> key = KeyRegistry::internFromIngest(field_key_)) {
+            event_.data[*key] = std::move(val);
+        }
+        return true;
+    }
+
+    // Lưu một giá trị không có kiểu EventValue tương ứng dưới dạng chuỗi JSON.
+    bool storeStringified(const json& val) {
+        if (field_key_ == "type") {
+            return fail("field 'type' must be a string");
+        }
+        if (isMetaKey(field_key_)) {
+            return true;
+        }
+        std::cerr << "[EventProcessor WARNING] Unsupported JSON type for key '" << field_key_ << "'. Storing as stringified JSON." << std::endl;
+        if (std::optional<KeyId> key = KeyRegistry::internFromIngest(field_key_)) {
+            event_.data[*key] = val.dump();
+        }
+        return true;
+    }
+
+    static bool isMetaKey(std::string_view key) {
+        return key == "_source_id" || key == "_timestamp";
+    }
+
+    // Thêm một số vào mảng số đang gom.
+    template <typename Number>
+    void addNumber(Number val) {
+        if constexpr (std::is_floating_point_v<Number>) {
+            promoteToDoubles();
+            doubles_.push_back(val);
+        } else {
+            if constexpr (std::is_unsigned_v<Number>) {
+                if (val > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                    promoteToDoubles(); // Không vừa int64_t: cả mảng thành mảng số thực
+                }
+            }
+            if (has_float_) {
+                doubles_.push_back(static_cast<double>(val));
+            } else {
+                ints_.push_back(static_cast<int64_t>(val));
+            }
+        }
+    }
+
+    // Chuyển các số nguyên đã gom sang mảng số thực (lần đầu gặp số thực).
+    void promoteToDoubles() {
+        if (has_float_) {
+            return;
+        }
+        has_float_ = true;
+        doubles_.reserve(ints_.size());
+        for (int64_t i : ints_) {
+            doubles_.push_back(static_cast<double>(i));
+        }
+        ints_.clear();
+    }
+
+    // Mảng đang gom hóa ra không thuần nhất: dựng cây JSON từ các số đã gom để tiếp tục.
+    void switchToNested() {
+        collecting_numbers_ = false;
+        nested_root_ = json::array();
+        if (has_float_) {
+            for (double d : doubles_) nested_root_.push_back(d);
+        } else {
+            for (int64_t i : ints_) nested_root_.push_back(i);
+        }
+        nested_stack_.clear();
+        nested_stack_.push_back(&nested_root_);
+    }
+
+    // Bắt đầu một object/mảng lồng nhau.
+    bool openNested(json container) {
+        if (collecting_numbers_) {
+            switchToNested();
+        }
+        if (nested_stack_.empty()) {
+            nested_root_ = std::move(container);
+            nested_stack_.push_back(&nested_root_);
+        } else {
+            nested_stack_.push_back(addNested(std::move(container)));
+        }
+        return true;
+    }
+
+    // Kết thúc một object/mảng lồng nhau; khi về tới cấp trường thì lưu dạng chuỗi JSON.
+    bool closeNested() {
+        nested_stack_.pop_back();
+        if (nested_stack_.empty()) {
+            bool ok = storeStringified(nested_root_);
+            nested_root_ = nullptr;
+            return ok;
+        }
+        return true;
+    }
+
+    // Thêm giá trị vào container lồng nhau hiện tại.
+    // @return Con trỏ tới phần tử vừa thêm.
+    json* addNested(json val) {
+        json* parent = nested_stack_.back();
+        if (parent->is_array()) {
+            parent->push_back(std::move(val));
+            return &parent->back();
+        }
+        json& slot = (*parent)[nested_key_];
+        slot = std::move(val);
+        return &slot;
+    }
+
+    bool fail(std::string message) {
+        error_ = std::move(message);
+        return false;
+    }
+
+    Event& event_;
+    int depth_ = 0;                    // Độ sâu hiện tại (1 = các trường của Event)
+    bool type_seen_ = false;
+    std::string field_key_;            // Key của trường cấp cao nhất đang xử lý
+    std::string nested_key_;           // Key trong object lồng nhau đang dựng
+
+    bool collecting_numbers_ = false;  // Đang gom một mảng số ở cấp trường
+    bool has_float_ = false;
+    EventIntArray ints_;
+    EventDoubleArray doubles_;
+
+    json nested_root_;                 // Giá trị lồng nhau đang dựng (chỉ khi cần lưu chuỗi JSON)
+    std::vector<json*> nested_stack_;
+
+    std::string error_;
+};
@@ -0,0 +1,136 @@
+// core/EventPool.h
+#pragma once
+
+#include "common/Event.h"
+#include <memory>  // Cho std::unique_ptr trong share()
+#include <vector>  // Danh sách Event rảnh
+#include <mutex>   // Bảo vệ danh sách Event rảnh
+#include <atomic>  // Bộ đếm cho stats()
+#include <cstdint> // Cho uint64_t
+
+// EventPool tái sử dụng các đối tượng Event trên đường đi từ EventProcessor đến RuleEngine.
+// Event trả về pool giữ lại bộ nhớ đã cấp phát của type/source (khi chuỗi dài hơn
+// bộ đệm SSO) và của EventData khi dữ liệu đã tràn ra heap. Lần dùng sau, EventProcessor
+// ghi đè nội dung bằng assign() nên không cần cấp phát lại.
+//
+// Luồng sử dụng điển hình:
+// - Producer (EventProcessor) gọi acquire() để lấy Event, điền dữ liệu rồi đẩy vào EventQueue.
+// - RuleEngine xử lý xong cả lô từ popBatch() thì gọi releaseBatch() để trả cả lô một lần.
+// - Event khớp quy tắc được chuyển thành EventRef qua share() trước khi dispatch; Event quay về
+//   pool khi hành động bất đồng bộ cuối cùng giữ nó chạy xong.
+// Pool chỉ giữ tối đa max_pooled Event; Event thừa bị hủy như bình thường.
+class EventPool {
+public:
+    // Số Event tối đa được giữ lại mặc định.
+    static constexpr size_t kDefaultMaxPooled = 1024;
+
+    // Bộ đếm của pool, dùng cho metric và benchmark.
+    struct Stats {
+        uint64_t acquired = 0; // Số lần acquire()
+        uint64_t reused = 0;   // Số lần acquire() lấy được Event tái sử dụng
+        uint64_t released = 0; // Số Event được trả về và giữ lại trong pool
+        uint64_t discarded = 0; // Số Event trả về nhưng bị hủy vì pool đã đầy
+    };
+
+    // Constructor của EventPool.
+    // @param max_pooled: Số Event tối đa được giữ lại để tái sử dụng.
+    explicit EventPool(size_t max_pooled = kDefaultMaxPooled) : max_pooled_(max_pooled) {
+        free_.reserve(max_pooled_);
+    }
+
+    EventPool(const EventPool&) = delete;
+    EventPool& operator=(const EventPool&) = delete;
+
+    // Phương thức acquire: Lấy một Event rỗng (tái sử dụng nếu có).
+    // Các trường chuỗi và dữ liệu đã được xóa nhưng vẫn giữ dung lượng đã cấp phát.
+    Event acquire() {
+        acquired_.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            return Event{};
+        }
+        Event event = std::move(free_.back());
+        free_.pop_back();
+        lock.unlock();
+        reused_.fetch_add(1, std::memory_order_relaxed);
+        return event;
+    }
+
+    // Phương thức release: Trả một Event về pool.
+    void release(Event&& event) {
+        reset(event);
+        std::unique_lock<std::mutex> lock(mutex_);
+        keep(std::move(event));
+    }
+
+    // Phương thức releaseBatch: Trả cả một lô Event về pool dưới một lần khóa.
+    // @param events: Các Event cần trả; vector được xóa (clear) sau khi gọi.
+    void releaseBatch(std::vector<Event>& events) {
+        for (auto& event : events) {
+            reset(event);
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (auto& event : events) {
+                keep(std::move(event));
+            }
+        }
+        events.clear();
+    }
+
+    // Phương thức share: Chuyển Event thành ảnh chụp bất biến dùng chung (EventRef).
+    // Khi EventRef cuối cùng được giải phóng (thường trên luồng của ActionDispatcher), nội dung Event
+    // được trả về pool như release(). Pool phải sống lâu hơn mọi EventRef do nó tạo ra.
+    // @param event: Event cần chia sẻ (được move vào ảnh chụp).
+    EventRef share(Event&& event) {
+        return EventRef(new Event(std::move(event)), [this](const Event* shared) {
+            std::unique_ptr<Event> owned(const_cast<Event*>(shared));
+            release(std::move(*owned));
+        });
+    }
+
+    // Phương thức size: Số Event đang rảnh trong pool.
+    size_t size() const {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return free_.size();
+    }
+
+    // Phương thức stats: Ảnh chụp các bộ đếm.
+    Stats stats() const {
+        Stats s;
+        s.acquired = acquired_.load(std::memory_order_relaxed);
+        s.reused = reused_.load(std::memory_order_relaxed);
+        s.released = released_.load(std::memory_order_relaxed);
+        s.discarded = discarded_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    // Xóa nội dung của Event nhưng giữ dung lượng của các chuỗi và của EventData.
+    static void reset(Event& event) {
+        event.id = 0;
+        event.type.clear();
+        event.source.clear();
+        event.timestamp = {};
+        event.data.clear();
+    }
+
+    // Giữ Event lại trong pool (caller đang giữ mutex_).
+    void keep(Event&& event) {
+        if (free_.size() >= max_pooled_) {
+            discarded_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        free_.push_back(std::move(event));
+        released_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const size_t max_pooled_;
+    std::vector<Event> free_;   // Các Event rảnh (LIFO để tận dụng cache)
+    mutable std::mutex mutex_;
+
+    std::atomic<uint64_t> acquired_{0};
+    std::atomic<uint64_t> reused_{0};
+    std::atomic<uint64_t> released_{0};
+    std::atomic<uint64_t> discarded_{0};
+};
@@ -3,126 +3,305 @@
 
 #include "common/Event.h"
 #include "core/EventQueue.h"
+#include "core/EventPool.h"
+#include "common/EventValueJson.h" // Chuyển giá trị JSON sang EventValue
+#include "core/EventJsonSax.h"         // Ghi JSON thẳng vào Event (không dựng DOM)
+#include "common/EventFields.h"    // Ánh xạ struct -> Event lúc biên dịch
+#include "common/IngestFilter.h"    // Lọc Event không thể khớp quy tắc nào
 #include <string>
 #include <string_view> // C++17 feature for efficient string passing
+#include <vector>      // Lô Event cho processRawJsonBatch
 #include <iostream>    // For logging/debug
 #include <stdexcept>   // For exceptions
+#include <memory>      // Cho std::shared_ptr<const IngestFilter>
+#include <atomic>      // Cho bộ đếm Event bị lọc
 
 // Nếu bạn vẫn cần nlohmann::json để xử lý các chuỗi JSON đầu vào phức tạp
 #include <nlohmann/json.hpp>
 
 // EventProcessor chịu trách nhiệm chuẩn hóa dữ liệu thô từ các InputSource
 // thành các đối tượng Event có cấu trúc và đẩy chúng vào EventQueue.
+// Nếu có IngestFilter (từ RuleManager), Event không thể khớp quy tắc nào bị loại trước khi vào hàng đợi;
+// payload thô từ nguồn không quy tắc nào quan tâm thậm chí không được phân tích.
 class EventProcessor {
 public:
     // Constructor nhận tham chiếu đến EventQueue
-    explicit EventProcessor(EventQueue& event_queue) : event_queue_(event_queue) {}
+    // @param event_pool: Pool tùy chọn để tái sử dụng Event (nullptr = tạo Event mới mỗi lần).
+    //                    Consumer của hàng đợi nên trả Event về cùng pool sau khi xử lý xong.
+    explicit EventProcessor(EventQueue& event_queue, EventPool* event_pool = nullptr)
+        : event_queue_(event_queue), event_pool_(event_pool) {}
+
+    // Phương thức setIngestFilter: Thay IngestFilter (an toàn luồng, có thể gọi khi đang xử lý).
+    // Thường được đăng ký qua RuleManager::subscribeIngestFilter để làm mới sau mỗi lần loadRules.
+    // @param filter: Filter mới, hoặc nullptr để nhận mọi Event.
+    void setIngestFilter(std::shared_ptr<const IngestFilter> filter) {
+        std::atomic_store(&ingest_filter_, std::move(filter));
+    }
+
+    // Phương thức filteredCount: Số Event đã bị IngestFilter loại.
+    uint64_t filteredCount() const {
+        return filtered_.load(std::memory_order_relaxed);
+    }
 
     // ---------------------------------------------------------------------
     // Quá tải (Overloads) của processRawData để xử lý các kiểu dữ liệu khác nhau
     // ---------------------------------------------------------------------
 
+    // Các hàm process* trả về true nếu Event được nhận vào EventQueue, false nếu dữ liệu lỗi,
+    // Event bị IngestFilter loại, hoặc bị hàng đợi từ chối (đầy theo OverflowPolicy, hoặc đã đóng).
+
     // 1. Quá tải cho các giá trị đơn lẻ (int, double, bool, std::string)
     // Tự động chuyển đổi kiểu T sang EventValue và đặt vào map data với một key mặc định.
     template <typename T>
-    void processRawData(std::string_view source_id, std::string_view event_type, const T& data_value, std::string_view data_key = "value") {
-        Event event;
-        event.id = generateUniqueId();
-        event.source = std::string(source_id);
-        event.type = std::string(event_type);
-        event.timestamp = std::chrono::system_clock::now();
+    bool processRawData(std::string_view source_id, std::string_view event_type, const T& data_value, std::string_view data_key = "value") {
+        std::shared_ptr<const IngestFilter> filter = ingestFilter();
+        if (filter && !filter->acceptsHeader(event_type, source_id)) {
+            filtered_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Event event = newEvent(source_id, event_type);
 
         try {
             // Tự động chuyển đổi T sang EventValue nhờ constructor của std::variant
-            event.data[std::string(data_key)] = data_value;
-            event_queue_.push(std::move(event));
+            event.data[data_key] = data_value;
+            if (filter && !filter->accepts(event)) {
+                discardFiltered(std::move(event));
+                return false;
+            }
+            if (!admit(std::move(event), source_id)) {
+                return false;
+            }
             std::cout << "[EventProcessor] Event from " << source_id << " (Type: " << event_type << ", Key: " << data_key << ") processed and pushed to queue. Queue size: " << event_queue_.size() << std::endl;
+            return true;
         } catch (const std::bad_variant_access& e) {
             std::cerr << "[EventProcessor ERROR] Type mismatch for " << source_id << ": " << e.what() << ". Data type not supported by EventValue." << std::endl;
+            recycle(std::move(event));
         } catch (const std::exception& e) {
             std::cerr << "[EventProcessor ERROR] Error processing simple data from " << source_id << ": " << e.what() << std::endl;
+            recycle(std::move(event));
         }
+        return false;
     }
 
     // 2. Quá tải để xử lý chuỗi JSON thô
     // Phân tích chuỗi JSON và ánh xạ các trường của nó vào Event::data.
-    void processRawJsonData(std::string_view source_id, std::string_view raw_json_string) {
-        Event event;
-        event.id = generateUniqueId();
-        event.source = std::string(source_id);
-        event.timestamp = std::chrono::system_clock::now();
+    // Dùng SAX parser (EventJsonSax): các trường được ghi thẳng vào Event trong một lần duyệt,
+    // không sao chép chuỗi đầu vào và không dựng DOM nlohmann::json trung gian.
+    bool processRawJsonData(std::string_view source_id, std::string_view raw_json_string) {
+        std::shared_ptr<const IngestFilter> filter = ingestFilter();
+        if (filter && !filter->acceptsSource(source_id)) {
+            filtered_.fetch_add(1, std::memory_order_relaxed); // Bỏ qua cả việc phân tích JSON
+            return false;
+        }
+        Event event = newEvent(source_id, {});
 
         try {
-            nlohmann::json json_obj = nlohmann::json::parse(std::string(raw_json_string));
-            event.type = json_obj.value("type", "generic_json_event"); // Lấy type từ JSON hoặc mặc định
-
-            // Duyệt qua các cặp key-value trong JSON object và chuyển đổi sang EventValue
-            for (auto it = json_obj.begin(); it != json_obj.end(); ++it) {
-                // Bỏ qua các trường meta hoặc trường 'type' đã xử lý
-                if (it.key() == "type" || it.key() == "_source_id" || it.key() == "_timestamp") {
-                    continue;
-                }
-
-                if (it->is_number_integer()) {
-                    event.data[it.key()] = it->get<int>();
-                } else if (it->is_number_float()) {
-                    event.data[it.key()] = it->get<double>();
-                } else if (it->is_boolean()) {
-                    event.data[it.key()] = it->get<bool>();
-                } else if (it->is_string()) {
-                    event.data[it.key()] = it->get<std::string>();
-                } else {
-                    // Xử lý các loại phức tạp hơn như arrays, nested objects
-                    // Đối với ví dụ này, chúng ta sẽ lưu chúng dưới dạng chuỗi JSON
-                    std::cerr << "[EventProcessor WARNING] Unsupported JSON type for key '" << it.key() << "'. Storing as stringified JSON." << std::endl;
-                    event.data[it.key()] = it->dump();
-                }
+            EventJsonSax sax(event);
+            if (!nlohmann::json::sax_parse(raw_json_string.begin(), raw_json_string.end(), &sax)) {
+                std::cerr << "[EventProcessor ERROR] JSON parse error for " << source_id << ": " << sax.error() << ". Raw data: " << raw_json_string << std::endl;
+                recycle(std::move(event));
+                return false;
+            }
+            if (filter && !filter->accepts(event)) {
+                discardFiltered(std::move(event));
+                return false;
+            }
+            if (!admit(std::move(event), source_id)) {
+                return false;
             }
-            event_queue_.push(std::move(event));
             std::cout << "[EventProcessor] JSON Event from " << source_id << " processed and pushed to queue. Queue size: " << event_queue_.size() << std::endl;
-        } catch (const nlohmann::json::parse_error& e) {
-            std::cerr << "[EventProcessor ERROR] JSON parse error for " << source_id << ": " << e.what() << ". Raw data: " << raw_json_string << std::endl;
+            return true;
         } catch (const std::exception& e) {
             std::cerr << "[EventProcessor ERROR] Error processing raw JSON data from " << source_id << ": " << e.what() << std::endl;
+            recycle(std::move(event));
+        }
+        return false;
+    }
+
+    // 2b. Xử lý một bộ đệm NDJSON (mỗi dòng là một JSON object) chứa nhiều bản ghi.
+    // Mỗi dòng được phân tích như processRawJsonData; dòng trống được bỏ qua, "\r" cuối dòng
+    // (CRLF) được cắt bỏ. Dòng lỗi được ghi log kèm số dòng và bỏ qua, không làm hỏng cả lô.
+    // Toàn bộ Event hợp lệ được đẩy vào EventQueue bằng một lần pushBatch (một lần khóa,
+    // một lần đánh thức consumer) và chỉ ghi một dòng log tổng kết cho cả lô.
+    // @return Số Event được nhận vào EventQueue.
+    size_t processRawJsonBatch(std::string_view source_id, std::string_view buffer) {
+        std::shared_ptr<const IngestFilter> filter = ingestFilter();
+        const bool skip_parse = filter && !filter->acceptsSource(source_id);
+        std::vector<Event> batch;
+        size_t parse_errors = 0;
+        size_t filtered = 0;
+        size_t line_number = 0;
+
+        while (!buffer.empty()) {
+            size_t newline = buffer.find('\n');
+            std::string_view line = buffer.substr(0, newline);
+            buffer.remove_prefix(newline == std::string_view::npos ? buffer.size() : newline + 1);
+            ++line_number;
+
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (line.find_first_not_of(" \t") == std::string_view::npos) {
+                continue; // Dòng trống
+            }
+            if (skip_parse) {
+                ++filtered; // Không quy tắc nào quan tâm nguồn này: không cần phân tích
+                continue;
+            }
+
+            Event event = newEvent(source_id, {});
+            try {
+                EventJsonSax sax(event);
+                if (!nlohmann::json::sax_parse(line.begin(), line.end(), &sax)) {
+                    std::cerr << "[EventProcessor ERROR] JSON parse error for " << source_id << " (line " << line_number << "): " << sax.error() << ". Raw data: " << line << std::endl;
+                    ++parse_errors;
+                    recycle(std::move(event));
+                    continue;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "[EventProcessor ERROR] Error processing raw JSON data from " << source_id << " (line " << line_number << "): " << e.what() << std::endl;
+                ++parse_errors;
+                recycle(std::move(event));
+                continue;
+            }
+            if (filter && !filter->accepts(event)) {
+                ++filtered;
+                recycle(std::move(event));
+                continue;
+            }
+            batch.push_back(std::move(event));
+        }
+
+        filtered_.fetch_add(filtered, std::memory_order_relaxed);
+        if (batch.empty()) {
+            return 0;
+        }
+        size_t parsed = batch.size();
+        std::vector<Event> rejected;
+        size_t admitted = event_queue_.pushBatch(batch, event_pool_ ? &rejected : nullptr);
+        if (event_pool_) {
+            event_pool_->releaseBatch(rejected); // Event không được nhận quay về pool
         }
+        if (admitted < parsed) {
+            std::cerr << "[EventProcessor WARNING] " << (parsed - admitted) << " of " << parsed << " events from " << source_id << " were not admitted to the queue ("
+                      << (event_queue_.isClosed() ? "queue closed" : "dropped by overflow policy") << ")." << std::endl;
+        }
+        std::cout << "[EventProcessor] NDJSON batch from " << source_id << ": " << admitted << " events pushed to queue";
+        if (parse_errors > 0) {
+            std::cout << ", " << parse_errors << " lines skipped";
+        }
+        if (filtered > 0) {
+            std::cout << ", " << filtered << " filtered";
+        }
+        std::cout << "." << std::endl;
+        return admitted;
     }
 
     // 3. Quá tải để xử lý các cấu trúc dữ liệu tùy chỉnh (struct/class)
-    // Yêu cầu struct/class có hàm to_json() friend function với nlohmann::json
+    // Nếu T được đăng ký bằng REPE_EVENT_FIELDS (xem common/EventFields.h), các thành viên được
+    // ghi thẳng vào Event::data, không có JSON trung gian.
+    // Nếu không, struct/class phải có hàm to_json() friend function với nlohmann::json.
     template <typename T>
-    void processStructuredData(std::string_view source_id, std::string_view event_type, const T& structured_data) {
-        Event event;
-        event.id = generateUniqueId();
-        event.source = std::string(source_id);
-        event.type = std::string(event_type);
-        event.timestamp = std::chrono::system_clock::now();
+    bool processStructuredData(std::string_view source_id, std::string_view event_type, const T& structured_data) {
+        std::shared_ptr<const IngestFilter> filter = ingestFilter();
+        if (filter && !filter->acceptsHeader(event_type, source_id)) {
+            filtered_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Event event = newEvent(source_id, event_type);
 
         try {
-            // Sử dụng hàm to_json của nlohmann::json để chuyển đổi T sang JSON object
-            nlohmann::json j_data = structured_data;
+            if constexpr (EventFields<T>::kRegistered) {
+                storeEventFields(event.data, structured_data);
+            } else {
+                // Sử dụng hàm to_json của nlohmann::json để chuyển đổi T sang JSON object
+                nlohmann::json j_data = structured_data;
 
-            if (!j_data.is_object()) {
-                 throw std::runtime_error("Structured data must be convertible to a JSON object.");
-            }
+                if (!j_data.is_object()) {
+                     throw std::runtime_error("Structured data must be convertible to a JSON object.");
+                }
 
-            for (auto it = j_data.begin(); it != j_data.end(); ++it) {
-                if (it->is_number_integer()) event.data[it.key()] = it->get<int>();
-                else if (it->is_number_float()) event.data[it.key()] = it->get<double>();
-                else if (it->is_boolean()) event.data[it.key()] = it->get<bool>();
-                else if (it->is_string()) event.data[it.key()] = it->get<std::string>();
-                else {
-                    std::cerr << "[EventProcessor WARNING] Unsupported JSON type for key '" << it.key() << "'. Storing as stringified JSON." << std::endl;
-                    event.data[it.key()] = it->dump();
+                for (auto it = j_data.begin(); it != j_data.end(); ++it) {
+                    storeJsonField(event, it.key(), it.value());
                 }
             }
-            event_queue_.push(std::move(event));
+            if (filter && !filter->accepts(event)) {
+                discardFiltered(std::move(event));
+                return false;
+            }
+            if (!admit(std::move(event), source_id)) {
+                return false;
+            }
             std::cout << "[EventProcessor] Structured Event from " << source_id << " (Type: " << event_type << ") processed and pushed to queue. Queue size: " << event_queue_.size() << std::endl;
+            return true;
 
         } catch (const std::exception& e) {
             std::cerr << "[EventProcessor ERROR] Error processing structured data from " << source_id << ": " << e.what() << std::endl;
+            recycle(std::move(event));
         }
+        return false;
     }
 
 private:
+    // Tạo Event mới (lấy từ event_pool_ nếu có) với id, source, type và timestamp.
+    // Dùng assign() để chuỗi của Event tái sử dụng giữ nguyên bộ nhớ đã cấp phát.
+    Event newEvent(std::string_view source_id, std::string_view event_type) {
+        Event event = event_pool_ ? event_pool_->acquire() : Event{};
+        event.id = generateUniqueId();
+        event.source.assign(source_id);
+        event.type.assign(event_type);
+        event.timestamp = std::chrono::system_clock::now();
+        return event;
+    }
+
+    // Ghi một trường JSON vào Event::data.
+    // Số nguyên 64-bit, mảng số thuần nhất và dữ liệu binary được giữ nguyên kiểu (xem EventValueJson.h).
+    // Chỉ object lồng nhau và mảng không thuần nhất mới được lưu dưới dạng chuỗi JSON.
+    // Key đến từ payload nên được intern qua KeyRegistry::internFromIngest (có giới hạn).
+    static void storeJsonField(Event& event, const std::string& key, const nlohmann::json& value) {
+        std::optional<KeyId> key_id = KeyRegistry::internFromIngest(key);
+        if (!key_id) {
+            return; // Bảng key đã đầy: bỏ trường mới này
+        }
+        if (std::optional<EventValue> converted = eventValueFromJson(value)) {
+            event.data[*key_id] = std::move(*converted);
+            return;
+        }
+        std::cerr << "[EventProcessor WARNING] Unsupported JSON type for key '" << key << "'. Storing as stringified JSON." << std::endl;
+        event.data[*key_id] = value.dump();
+    }
+
+    std::shared_ptr<const IngestFilter> ingestFilter() const {
+        return std::atomic_load(&ingest_filter_);
+    }
+
+    // Trả Event không được đẩy vào EventQueue (lỗi phân tích, bị lọc, bị từ chối) về pool (nếu có).
+    void recycle(Event&& event) {
+        if (event_pool_) {
+            event_pool_->release(std::move(event));
+        }
+    }
+
+    // Đếm Event bị IngestFilter loại và trả nó về pool (nếu có).
+    void discardFiltered(Event&& event) {
+        filtered_.fetch_add(1, std::memory_order_relaxed);
+        recycle(std::move(event));
+    }
+
+    // Đẩy Event vào EventQueue; nếu nó bị từ chối thì ghi log và trả nó về pool.
+    // @return true nếu Event được nhận vào hàng đợi.
+    bool admit(Event&& event, std::string_view source_id) {
+        if (event_queue_.pushOrKeep(event)) {
+            return true;
+        }
+        recycle(std::move(event));
+        std::cerr << "[EventProcessor WARNING] Event from " << source_id << " was not admitted to the queue ("
+                  << (event_queue_.isClosed() ? "queue closed" : "dropped by overflow policy") << ")." << std::endl;
+        return false;
+    }
+
     EventQueue& event_queue_; // Tham chiếu đến EventQueue
+    EventPool* event_pool_;   // Pool tái sử dụng Event (có thể là nullptr)
+    std::shared_ptr<const IngestFilter> ingest_filter_; // nullptr = nhận mọi Event (đọc/ghi bằng std::atomic_load/store)
+    std::atomic<uint64_t> filtered_{0};                 // Số Event bị IngestFilter loại
 };
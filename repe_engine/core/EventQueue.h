@@ -2,61 +2,684 @@
 #pragma once
 
 #include "common/Event.h" // Bao gồm Event mới
+#include "core/MpmcRingBuffer.h" // Ring buffer lock-free cho backend LockFree
 #include <queue>              // Để sử dụng std::queue làm cấu trúc dữ liệu cơ bản
 #include <mutex>              // Để đảm bảo an toàn luồng (thread-safety)
 #include <condition_variable> // Để đồng bộ hóa các luồng producer/consumer
 #include <optional>           // C++17 feature for std::optional
+#include <atomic>             // Cho bộ đếm consumer đang ngủ (backend LockFree) và cờ closed_
+#include <memory>             // Cho std::unique_ptr
+#include <thread>             // Cho std::this_thread::yield
+#include <vector>             // Cho popBatch và danh sách lane
+#include <map>                // Cho ánh xạ type/source -> lane
+#include <string>             // Cho khóa của ánh xạ lane
+#include <chrono>             // Cho popFor/popUntil/popBatch
+#include <stdexcept>          // Cho std::runtime_error
+#include <random>             // Cho chính sách OverflowPolicy::Sample
+#include <cstdint>            // Cho bộ đếm uint64_t
 
 // EventQueue là một hàng đợi an toàn luồng, được sử dụng để đệm các Event.
 // Đây là thành phần cốt lõi của Producer-Consumer Pattern.
+//
+// Có hai backend, chọn khi khởi tạo:
+// - Mutex:    std::queue không giới hạn, bảo vệ bởi một mutex (hành vi mặc định).
+// - LockFree: MpmcRingBuffer có giới hạn, push/tryPop không cần khóa.
+//             Khi đầy với chính sách Block, push() sẽ chờ (yield) cho đến khi consumer giải phóng slot.
+//             Mutex/condition_variable chỉ được dùng để cho consumer ngủ khi hàng đợi trống.
+//
+// Hàng đợi có thể được giới hạn dung lượng (Options::capacity). Khi đầy, OverflowPolicy
+// quyết định điều gì xảy ra với Event mới: chặn producer, bỏ Event mới, bỏ Event cũ nhất,
+// hoặc lấy mẫu xác suất khi hàng đợi vượt ngưỡng. Mỗi chính sách có bộ đếm riêng (stats()).
+//
+// Hàng đợi có thể chia thành nhiều lane ưu tiên (Options::lanes). Event được xếp vào lane
+// theo Event::type hoặc tiền tố Event::source; consumer lấy Event theo ưu tiên tuyệt đối
+// (lane 0 trước) hoặc theo trọng số. Dung lượng và OverflowPolicy áp dụng cho từng lane,
+// nên một nguồn ồn ào không thể chiếm chỗ của các Event quan trọng.
+//
+// close() đánh thức ngay lập tức mọi luồng đang chờ. Sau khi đóng, push() bị từ chối
+// còn các hàm pop vẫn lấy nốt các Event còn lại trước khi báo hàng đợi đã cạn.
 class EventQueue {
 public:
-    // Phương thức push: Đẩy một Event vào hàng đợi.
+    enum class Backend {
+        Mutex,
+        LockFree
+    };
+
+    // Chính sách xử lý khi hàng đợi có giới hạn bị đầy.
+    enum class OverflowPolicy {
+        Block,      // Producer chờ cho đến khi có chỗ trống (hoặc hàng đợi bị đóng)
+        DropNewest, // Bỏ Event đang được đẩy vào
+        DropOldest, // Bỏ Event cũ nhất trong hàng đợi để nhường chỗ cho Event mới
+        Sample      // Khi vượt ngưỡng sample_threshold, nhận Event với xác suất giảm dần về 0 khi đầy
+    };
+
+    // Cách consumer chọn lane khi có nhiều lane cùng có Event.
+    enum class LaneScheduling {
+        StrictPriority, // Luôn lấy từ lane có chỉ số nhỏ nhất còn Event
+        Weighted        // Chia lượt theo LaneOptions::weights, lane trống nhường lượt cho lane khác
+    };
+
+    // Cấu hình lane ưu tiên. Mặc định chỉ có một lane (hành vi FIFO thông thường).
+    struct LaneOptions {
+        size_t count = 1;                                // Số lane; lane 0 có ưu tiên cao nhất
+        std::map<std::string, size_t> by_type;           // Event::type -> lane (được xét trước)
+        std::map<std::string, size_t> by_source_prefix;  // Tiền tố Event::source -> lane
+        size_t default_lane = 0;                         // Lane cho Event không khớp ánh xạ nào
+        LaneScheduling scheduling = LaneScheduling::StrictPriority;
+        std::vector<unsigned> weights;                   // Trọng số mỗi lane (chỉ dùng cho Weighted)
+    };
+
+    // Dung lượng mặc định của backend LockFree (phải là lũy thừa của 2).
+    static constexpr size_t kDefaultLockFreeCapacity = 4096;
+
+    // Cấu hình đầy đủ của hàng đợi.
+    struct Options {
+        Backend backend = Backend::Mutex;
+        // Số Event tối đa của mỗi lane. 0 nghĩa là không giới hạn (chỉ hợp lệ với Backend::Mutex).
+        // Với Backend::LockFree phải là lũy thừa của 2.
+        size_t capacity = 0;
+        OverflowPolicy overflow_policy = OverflowPolicy::Block;
+        // Tỉ lệ lấp đầy (0..1) bắt đầu lấy mẫu, chỉ dùng cho OverflowPolicy::Sample.
+        double sample_threshold = 0.5;
+        LaneOptions lanes;
+    };
+
+    // Bộ đếm của hàng đợi, dùng cho metric và log.
+    struct Stats {
+        uint64_t admitted = 0;        // Số Event đã được nhận vào hàng đợi
+        uint64_t blocked_pushes = 0;  // Số lần push phải chờ vì hàng đợi đầy (Block)
+        uint64_t dropped_newest = 0;  // Số Event mới bị bỏ vì hàng đợi đầy (DropNewest)
+        uint64_t dropped_oldest = 0;  // Số Event cũ bị bỏ để nhường chỗ (DropOldest)
+        uint64_t dropped_sampled = 0; // Số Event bị loại khi lấy mẫu (Sample)
+        uint64_t rejected_closed = 0; // Số Event bị từ chối vì hàng đợi đã đóng
+    };
+
+    // Constructor: chọn backend cho hàng đợi.
+    // Backend::Mutex không giới hạn; Backend::LockFree giới hạn bởi capacity với chính sách Block.
+    // @param backend: Backend::Mutex (mặc định) hoặc Backend::LockFree.
+    // @param capacity: Dung lượng của ring buffer, chỉ dùng cho Backend::LockFree.
+    // @throws std::invalid_argument nếu capacity không hợp lệ cho Backend::LockFree.
+    explicit EventQueue(Backend backend = Backend::Mutex, size_t capacity = kDefaultLockFreeCapacity)
+        : EventQueue(Options{backend, backend == Backend::LockFree ? capacity : 0, OverflowPolicy::Block, 0.5, {}}) {}
+
+    // Constructor: cấu hình đầy đủ (backend, dung lượng, chính sách khi đầy, lane ưu tiên).
+    // @throws std::invalid_argument nếu cấu hình không hợp lệ.
+    explicit EventQueue(const Options& options)
+        : backend_(options.backend),
+          capacity_(options.capacity),
+          overflow_policy_(options.overflow_policy),
+          sample_threshold_(options.sample_threshold),
+          lane_options_(options.lanes) {
+        if (sample_threshold_ < 0.0 || sample_threshold_ >= 1.0) {
+            throw std::invalid_argument("EventQueue sample_threshold must be in [0, 1).");
+        }
+        validateLanes(options.lanes);
+
+        lanes_.resize(options.lanes.count);
+        if (backend_ == Backend::LockFree) {
+            for (auto& lane : lanes_) {
+                lane.ring = std::make_unique<MpmcRingBuffer<Event>>(capacity_);
+            }
+        }
+        if (options.lanes.scheduling == LaneScheduling::Weighted) {
+            buildWeightedSchedule(options.lanes.weights);
+        }
+    }
+
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    // Phương thức push: Đẩy một Event vào hàng đợi (vào lane tương ứng với Event).
     // Event được chuyển bằng std::move để tránh sao chép không cần thiết.
-    void push(Event event) {
+    // Khi lane có giới hạn bị đầy, hành vi phụ thuộc vào OverflowPolicy.
+    // @return true nếu Event được nhận vào hàng đợi, false nếu nó bị bỏ
+    //         (theo chính sách khi đầy) hoặc hàng đợi đã bị đóng.
+    bool push(Event event) {
+        return pushOrKeep(event);
+    }
+
+    // Phương thức pushOrKeep: Như push(), nhưng Event chỉ bị move khi được nhận vào hàng đợi.
+    // Event bị từ chối vẫn nằm trong 'event' để caller xử lý tiếp (ví dụ trả về EventPool).
+    // @return true nếu Event được nhận vào hàng đợi.
+    bool pushOrKeep(Event& event) {
+        Lane& lane = lanes_[laneFor(event)];
+        if (backend_ == Backend::LockFree) {
+            return pushRing(*lane.ring, event);
+        }
         std::unique_lock<std::mutex> lock(mutex_); // Khóa mutex để truy cập queue an toàn
-        queue_.push(std::move(event));             // Di chuyển Event vào queue
+        if (!pushLocked(lock, lane, event)) {
+            return false;
+        }
         condition_.notify_one();                   // Thông báo cho một luồng đang chờ (nếu có) rằng có dữ liệu mới
+        return true;
+    }
+
+    // Phương thức pushBatch: Đẩy nhiều Event vào hàng đợi trong một lần truy cập.
+    // Với backend Mutex, cả lô được đẩy dưới một lần khóa mutex và consumer chỉ được đánh thức
+    // một lần ở cuối. Mỗi Event vẫn được xếp lane và áp dụng OverflowPolicy như push().
+    // @param events: Các Event cần đẩy (được move); vector được xóa (clear) sau khi gọi.
+    // @param rejected: Nếu khác nullptr, các Event không được nhận được chuyển vào đây (theo thứ tự).
+    // @return Số Event được nhận vào hàng đợi.
+    size_t pushBatch(std::vector<Event>& events, std::vector<Event>* rejected = nullptr) {
+        size_t admitted = 0;
+        if (backend_ == Backend::LockFree) {
+            for (auto& event : events) {
+                if (pushRing(*lanes_[laneFor(event)].ring, event)) {
+                    ++admitted;
+                } else if (rejected) {
+                    rejected->push_back(std::move(event));
+                }
+            }
+        } else {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (auto& event : events) {
+                if (pushLocked(lock, lanes_[laneFor(event)], event)) {
+                    ++admitted;
+                } else if (rejected) {
+                    rejected->push_back(std::move(event));
+                }
+            }
+            lock.unlock();
+            if (admitted == 1) {
+                condition_.notify_one();
+            } else if (admitted > 1) {
+                condition_.notify_all();
+            }
+        }
+        events.clear();
+        return admitted;
     }
 
     // Phương thức pop: Lấy một Event từ hàng đợi.
     // Nếu hàng đợi trống, luồng gọi sẽ chờ cho đến khi có Event mới.
+    // @throws std::runtime_error nếu hàng đợi bị đóng và đã cạn trong lúc chờ.
     Event pop() {
-        std::unique_lock<std::mutex> lock(mutex_); // Khóa mutex
-        // Chờ cho đến khi hàng đợi không trống. Hàm lambda là predicate.
-        condition_.wait(lock, [this]{ return !queue_.empty(); });
-
-        Event event = std::move(queue_.front()); // Lấy Event đầu tiên bằng cách di chuyển
-        queue_.pop();                             // Xóa Event khỏi queue
-        return event;
+        std::optional<Event> event = waitAndPop([this](std::unique_lock<std::mutex>& lock, auto pred) {
+            condition_.wait(lock, pred);
+            return true;
+        });
+        if (!event) {
+            throw std::runtime_error("pop on closed and drained EventQueue");
+        }
+        return std::move(*event);
     }
 
     // Phương thức tryPop: Cố gắng lấy một Event từ hàng đợi mà không chờ.
     // Trả về std::optional<Event> để biểu thị có hoặc không có Event.
     std::optional<Event> tryPop() {
+        Event event;
+        if (backend_ == Backend::LockFree) {
+            if (!takeRing(event)) {
+                return std::nullopt;
+            }
+            return event;
+        }
         std::unique_lock<std::mutex> lock(mutex_); // Khóa mutex
-        if (queue_.empty()) {
+        if (!takeLocked(event)) {
             return std::nullopt; // Trả về nullopt nếu hàng đợi trống
         }
-        Event event = std::move(queue_.front()); // Lấy Event đầu tiên
-        queue_.pop();                             // Xóa Event khỏi queue
         return event;
     }
 
+    // Phương thức popFor: Lấy một Event, chờ tối đa timeout nếu hàng đợi trống.
+    // Luồng chờ được đánh thức ngay khi có Event mới hoặc khi close() được gọi.
+    // @return Event, hoặc std::nullopt nếu hết thời gian chờ hoặc hàng đợi đã đóng và cạn.
+    template <typename Rep, typename Period>
+    std::optional<Event> popFor(std::chrono::duration<Rep, Period> timeout) {
+        return popUntil(std::chrono::steady_clock::now() + timeout);
+    }
+
+    // Phương thức popUntil: Giống popFor nhưng nhận một thời điểm deadline.
+    template <typename Clock, typename Duration>
+    std::optional<Event> popUntil(std::chrono::time_point<Clock, Duration> deadline) {
+        return waitAndPop([this, deadline](std::unique_lock<std::mutex>& lock, auto pred) {
+            return condition_.wait_until(lock, deadline, pred);
+        });
+    }
+
+    // Phương thức popBatch: Lấy tối đa max_n Event trong một lần truy cập hàng đợi.
+    // Chờ tối đa timeout cho đến khi có ít nhất một Event, sau đó lấy hết những gì đang có
+    // (không quá max_n) mà không chờ thêm. Với backend Mutex, toàn bộ lô được lấy
+    // dưới một lần khóa mutex duy nhất thay vì một lần khóa cho mỗi Event.
+    // Thứ tự trong lô tuân theo LaneScheduling, giống như gọi tryPop liên tiếp.
+    // @param out: Vector nhận các Event (được nối thêm vào cuối, không bị xóa trước).
+    // @param max_n: Số Event tối đa cần lấy.
+    // @param timeout: Thời gian chờ tối đa khi hàng đợi trống.
+    // @return Số Event đã lấy được (0 nếu hết thời gian chờ hoặc hàng đợi đã đóng và cạn).
+    template <typename Rep, typename Period>
+    size_t popBatch(std::vector<Event>& out, size_t max_n, std::chrono::duration<Rep, Period> timeout) {
+        if (max_n == 0) {
+            return 0;
+        }
+        if (backend_ == Backend::LockFree) {
+            size_t count = drainRing(out, max_n);
+            if (count > 0 || isClosed()) {
+                return count;
+            }
+            parkConsumer([&](std::unique_lock<std::mutex>& lock) {
+                condition_.wait_for(lock, timeout, [&]{
+                    count = drainRing(out, max_n);
+                    return count > 0 || isClosed();
+                });
+            });
+            return count;
+        }
+        std::unique_lock<std::mutex> lock(mutex_); // Khóa mutex một lần cho cả lô
+        condition_.wait_for(lock, timeout, [this]{ return total_size_ > 0 || isClosed(); });
+        size_t count = 0;
+        Event event;
+        while (count < max_n && takeLocked(event)) {
+            out.push_back(std::move(event));
+            ++count;
+        }
+        return count;
+    }
+
+    // Phương thức close: Đóng hàng đợi và đánh thức tất cả các luồng đang chờ.
+    // Dùng khi tắt hệ thống: consumer thoát khỏi trạng thái chờ ngay lập tức
+    // thay vì phải đợi hết timeout. Gọi nhiều lần không có tác dụng phụ.
+    void close() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            closed_.store(true, std::memory_order_release);
+        }
+        condition_.notify_all();
+        not_full_.notify_all(); // Producer đang bị chặn (OverflowPolicy::Block) cũng được giải phóng
+    }
+
+    // Phương thức isClosed: Kiểm tra xem close() đã được gọi chưa.
+    bool isClosed() const {
+        return closed_.load(std::memory_order_acquire);
+    }
+
     // Phương thức isEmpty: Kiểm tra xem hàng đợi có trống không.
     bool isEmpty() const {
-        std::unique_lock<std::mutex> lock(mutex_); // Khóa mutex
-        return queue_.empty();
+        return size() == 0;
     }
 
-    // Phương thức size: Lấy số lượng phần tử hiện có trong hàng đợi.
+    // Phương thức size: Lấy số lượng phần tử hiện có trong hàng đợi (tổng mọi lane).
+    // Với backend LockFree, giá trị là xấp xỉ khi có push/pop đồng thời.
     size_t size() const {
+        if (backend_ == Backend::LockFree) {
+            size_t total = 0;
+            for (const auto& lane : lanes_) {
+                total += lane.ring->sizeApprox();
+            }
+            return total;
+        }
         std::unique_lock<std::mutex> lock(mutex_); // Khóa mutex
-        return queue_.size();
+        return total_size_;
+    }
+
+    // Phương thức laneSize: Số Event hiện có trong một lane (dùng cho metric).
+    // @throws std::out_of_range nếu lane không tồn tại.
+    size_t laneSize(size_t lane) const {
+        const Lane& l = lanes_.at(lane);
+        if (backend_ == Backend::LockFree) {
+            return l.ring->sizeApprox();
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        return l.queue.size();
+    }
+
+    // Phương thức laneCount: Số lane ưu tiên.
+    size_t laneCount() const { return lanes_.size(); }
+
+    // Phương thức laneOptions: Cấu hình lane đã chọn khi khởi tạo
+    // (dùng để tạo hàng đợi khác xếp Event vào lane giống hệt, xem RuleEngine).
+    const LaneOptions& laneOptions() const { return lane_options_; }
+
+    // Phương thức laneFor: Lane mà một Event sẽ được xếp vào.
+    // Event::type được xét trước, sau đó đến tiền tố dài nhất của Event::source.
+    size_t laneFor(const Event& event) const {
+        if (lanes_.size() == 1) {
+            return 0;
+        }
+        auto type_it = lane_options_.by_type.find(event.type);
+        if (type_it != lane_options_.by_type.end()) {
+            return type_it->second;
+        }
+        size_t best_lane = lane_options_.default_lane;
+        size_t best_length = 0;
+        for (const auto& [prefix, lane] : lane_options_.by_source_prefix) {
+            if (prefix.size() >= best_length && event.source.compare(0, prefix.size(), prefix) == 0) {
+                best_lane = lane;
+                best_length = prefix.size();
+            }
+        }
+        return best_lane;
+    }
+
+    // Phương thức backend: Trả về backend đã chọn khi khởi tạo.
+    Backend backend() const { return backend_; }
+
+    // Phương thức capacity: Dung lượng tối đa của mỗi lane (0 nghĩa là không giới hạn).
+    size_t capacity() const { return capacity_; }
+
+    // Phương thức overflowPolicy: Chính sách khi đầy đã chọn khi khởi tạo.
+    OverflowPolicy overflowPolicy() const { return overflow_policy_; }
+
+    // Phương thức stats: Ảnh chụp các bộ đếm (không khóa, có thể lệch nhẹ khi đang có push đồng thời).
+    Stats stats() const {
+        Stats s;
+        s.admitted = admitted_.load(std::memory_order_relaxed);
+        s.blocked_pushes = blocked_pushes_.load(std::memory_order_relaxed);
+        s.dropped_newest = dropped_newest_.load(std::memory_order_relaxed);
+        s.dropped_oldest = dropped_oldest_.load(std::memory_order_relaxed);
+        s.dropped_sampled = dropped_sampled_.load(std::memory_order_relaxed);
+        s.rejected_closed = rejected_closed_.load(std::memory_order_relaxed);
+        return s;
     }
 
 private:
-    std::queue<Event> queue_;             // Hàng đợi chứa các Event
+    // Một lane ưu tiên: std::queue cho backend Mutex hoặc ring buffer cho backend LockFree.
+    struct Lane {
+        std::queue<Event> queue;
+        std::unique_ptr<MpmcRingBuffer<Event>> ring;
+    };
+
+    // Đẩy một Event vào lane theo OverflowPolicy (backend Mutex, caller đang giữ mutex_).
+    // Không đánh thức consumer; caller tự gọi notify sau khi đẩy xong.
+    // @return true nếu Event được nhận vào hàng đợi.
+    bool pushLocked(std::unique_lock<std::mutex>& lock, Lane& lane, Event& event) {
+        if (closed_.load(std::memory_order_relaxed)) {
+            rejected_closed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        std::queue<Event>& queue = lane.queue;
+        if (capacity_ > 0) {
+            if (overflow_policy_ == OverflowPolicy::Sample && !sampleAdmit(queue.size())) {
+                dropped_sampled_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            if (queue.size() >= capacity_) {
+                switch (overflow_policy_) {
+                case OverflowPolicy::Block:
+                    blocked_pushes_.fetch_add(1, std::memory_order_relaxed);
+                    ++waiting_producers_;
+                    // Các Event vừa đẩy trong cùng lô (pushBatch) chưa được báo cho consumer:
+                    // đánh thức họ trước khi chờ, nếu không lane sẽ không bao giờ có chỗ trống.
+                    condition_.notify_all();
+                    not_full_.wait(lock, [&]{ return queue.size() < capacity_ || isClosed(); });
+                    --waiting_producers_;
+                    if (isClosed()) {
+                        rejected_closed_.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    break;
+                case OverflowPolicy::DropOldest:
+                    queue.pop();
+                    --total_size_;
+                    dropped_oldest_.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                case OverflowPolicy::DropNewest:
+                case OverflowPolicy::Sample: // Đầy hẳn: không còn chỗ dù được lấy mẫu
+                    dropped_newest_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+        }
+        queue.push(std::move(event));              // Di chuyển Event vào lane
+        ++total_size_;
+        admitted_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Số lần thử tryPop không khóa trước khi consumer đi ngủ trên condition_.
+    static constexpr int kSpinBeforeSleep = 64;
+
+    // Kiểm tra cấu hình lane.
+    // @throws std::invalid_argument nếu có chỉ số lane hoặc trọng số không hợp lệ.
+    static void validateLanes(const LaneOptions& lanes) {
+        if (lanes.count == 0) {
+            throw std::invalid_argument("EventQueue needs at least one lane.");
+        }
+        auto check = [&](size_t lane) {
+            if (lane >= lanes.count) {
+                throw std::invalid_argument("EventQueue lane index out of range: " + std::to_string(lane));
+            }
+        };
+        check(lanes.default_lane);
+        for (const auto& entry : lanes.by_type) check(entry.second);
+        for (const auto& entry : lanes.by_source_prefix) check(entry.second);
+        if (lanes.scheduling == LaneScheduling::Weighted) {
+            if (lanes.weights.size() != lanes.count) {
+                throw std::invalid_argument("EventQueue weighted scheduling needs one weight per lane.");
+            }
+            for (unsigned weight : lanes.weights) {
+                if (weight == 0) {
+                    throw std::invalid_argument("EventQueue lane weights must be positive.");
+                }
+            }
+        }
+    }
+
+    // Xây lịch chia lượt theo trọng số (smooth weighted round-robin), ví dụ trọng số {3, 1}
+    // cho lịch {0, 0, 1, 0}: các lượt của một lane được rải đều thay vì dồn thành cụm.
+    void buildWeightedSchedule(const std::vector<unsigned>& weights) {
+        long total = 0;
+        for (unsigned weight : weights) {
+            total += weight;
+        }
+        std::vector<long> current(weights.size(), 0);
+        for (long turn = 0; turn < total; ++turn) {
+            size_t best = 0;
+            for (size_t i = 0; i < weights.size(); ++i) {
+                current[i] += weights[i];
+                if (current[i] > current[best]) {
+                    best = i;
+                }
+            }
+            current[best] -= total;
+            weighted_schedule_.push_back(best);
+        }
+    }
+
+    // Thử lấy Event theo thứ tự lane của LaneScheduling.
+    // try_lane(i) cố gắng lấy một Event từ lane i và trả về true nếu thành công.
+    // Weighted: lane đến lượt được thử trước, sau đó các lane còn lại theo thứ tự ưu tiên,
+    // để lane trống không làm mất lượt của các lane khác.
+    template <typename TryLane>
+    bool takeScheduled(TryLane try_lane) {
+        size_t first = 0;
+        if (!weighted_schedule_.empty()) {
+            size_t turn = schedule_turn_.fetch_add(1, std::memory_order_relaxed);
+            first = weighted_schedule_[turn % weighted_schedule_.size()];
+        }
+        if (try_lane(first)) {
+            return true;
+        }
+        for (size_t i = 0; i < lanes_.size(); ++i) {
+            if (i != first && try_lane(i)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Lấy một Event (backend Mutex, caller đang giữ mutex_).
+    // Đánh thức các producer đang bị chặn vì lane đầy, nếu có.
+    bool takeLocked(Event& out) {
+        if (total_size_ == 0) {
+            return false;
+        }
+        return takeScheduled([&](size_t i) {
+            std::queue<Event>& queue = lanes_[i].queue;
+            if (queue.empty()) {
+                return false;
+            }
+            out = std::move(queue.front()); // Lấy Event đầu tiên bằng cách di chuyển
+            queue.pop();                     // Xóa Event khỏi lane
+            --total_size_;
+            if (waiting_producers_ > 0) {
+                // Producer có thể đang chờ trên các lane khác nhau nên đánh thức tất cả.
+                not_full_.notify_all();
+            }
+            return true;
+        });
+    }
+
+    // Lấy một Event không khóa (backend LockFree).
+    bool takeRing(Event& out) {
+        return takeScheduled([&](size_t i) { return lanes_[i].ring->tryPop(out); });
+    }
+
+    // Logic chờ chung cho pop/popFor/popUntil.
+    // wait(lock, pred) thực hiện việc chờ trên condition_ (vô hạn hoặc có deadline)
+    // và trả về false nếu hết thời gian chờ.
+    // @return Event, hoặc std::nullopt nếu hết thời gian chờ hoặc hàng đợi đã đóng và cạn.
+    template <typename Wait>
+    std::optional<Event> waitAndPop(Wait wait) {
+        Event event;
+        if (backend_ == Backend::LockFree) {
+            // Thử vài lần không khóa trước khi ngủ: trong tải cao event thường đến ngay.
+            for (int spin = 0; spin < kSpinBeforeSleep; ++spin) {
+                if (takeRing(event)) {
+                    return event;
+                }
+                if (isClosed()) {
+                    return std::nullopt;
+                }
+                std::this_thread::yield();
+            }
+            bool got = false;
+            parkConsumer([&](std::unique_lock<std::mutex>& lock) {
+                wait(lock, [&]{
+                    got = takeRing(event);
+                    return got || isClosed();
+                });
+            });
+            if (!got) {
+                return std::nullopt;
+            }
+            return event;
+        }
+        std::unique_lock<std::mutex> lock(mutex_); // Khóa mutex
+        // Chờ cho đến khi hàng đợi không trống hoặc bị đóng. Hàm lambda là predicate.
+        wait(lock, [this]{ return total_size_ > 0 || isClosed(); });
+        if (!takeLocked(event)) {
+            return std::nullopt; // Hết thời gian chờ, hoặc hàng đợi đã đóng và cạn
+        }
+        return event;
+    }
+
+    // Đẩy Event vào ring buffer của một lane theo OverflowPolicy (backend LockFree).
+    bool pushRing(MpmcRingBuffer<Event>& ring, Event& event) {
+        if (isClosed()) {
+            rejected_closed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (overflow_policy_ == OverflowPolicy::Sample && !sampleAdmit(ring.sizeApprox())) {
+            dropped_sampled_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        bool counted_block = false;
+        while (!ring.tryPush(event)) {
+            switch (overflow_policy_) {
+            case OverflowPolicy::Block:
+                if (isClosed()) {
+                    rejected_closed_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                if (!counted_block) {
+                    blocked_pushes_.fetch_add(1, std::memory_order_relaxed);
+                    counted_block = true;
+                }
+                // Ring buffer đầy: nhường CPU cho consumer thay vì quay vòng liên tục.
+                std::this_thread::yield();
+                break;
+            case OverflowPolicy::DropOldest: {
+                // Producer tự lấy Event cũ nhất ra để nhường chỗ; nếu consumer đã lấy trước
+                // thì vòng lặp chỉ đơn giản thử ghi lại.
+                Event oldest;
+                if (ring.tryPop(oldest)) {
+                    dropped_oldest_.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            }
+            case OverflowPolicy::DropNewest:
+            case OverflowPolicy::Sample:
+                dropped_newest_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        admitted_.fetch_add(1, std::memory_order_relaxed);
+        wakeSleepingConsumer();
+        return true;
+    }
+
+    // Quyết định có nhận Event hay không theo OverflowPolicy::Sample.
+    // Dưới ngưỡng sample_threshold_ luôn nhận; từ ngưỡng đến đầy, xác suất nhận giảm tuyến tính về 0.
+    // @param current_size: Số Event hiện có trong lane.
+    bool sampleAdmit(size_t current_size) const {
+        const double fill = static_cast<double>(current_size) / static_cast<double>(capacity_);
+        if (fill < sample_threshold_) {
+            return true;
+        }
+        const double keep_probability = (1.0 - fill) / (1.0 - sample_threshold_);
+        thread_local std::minstd_rand rng(std::random_device{}());
+        return std::uniform_real_distribution<double>(0.0, 1.0)(rng) < keep_probability;
+    }
+
+    // Cho consumer ngủ trên condition_ (backend LockFree).
+    // Đăng ký vào sleeping_consumers_ trước khi khóa mutex để producer biết cần đánh thức.
+    template <typename Wait>
+    void parkConsumer(Wait wait) {
+        sleeping_consumers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wait(lock);
+        }
+        sleeping_consumers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Lấy tối đa max_n Event từ các ring buffer mà không chờ (backend LockFree).
+    size_t drainRing(std::vector<Event>& out, size_t max_n) {
+        size_t count = 0;
+        Event event;
+        while (count < max_n && takeRing(event)) {
+            out.push_back(std::move(event));
+            ++count;
+        }
+        return count;
+    }
+
+    // Đánh thức một consumer đang ngủ (backend LockFree).
+    // Producer chỉ chạm vào mutex khi thật sự có consumer đang chờ, nên trong tải cao
+    // đường push hoàn toàn không khóa. Fence seq_cst ghép cặp với fence trong parkConsumer()
+    // để producer không bỏ lỡ consumer vừa đăng ký ngủ.
+    void wakeSleepingConsumer() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_consumers_.load(std::memory_order_relaxed) > 0) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.notify_one();
+        }
+    }
+
+    Backend backend_;                     // Backend đã chọn khi khởi tạo
+    size_t capacity_;                     // Dung lượng tối đa của mỗi lane (0 = không giới hạn)
+    OverflowPolicy overflow_policy_;      // Chính sách khi hàng đợi đầy
+    double sample_threshold_;             // Ngưỡng bắt đầu lấy mẫu (OverflowPolicy::Sample)
+
+    std::vector<Lane> lanes_;             // Các lane ưu tiên, lane 0 cao nhất
+    LaneOptions lane_options_;            // Ánh xạ Event -> lane và cách chia lượt
+    std::vector<size_t> weighted_schedule_; // Lịch chia lượt (rỗng với StrictPriority)
+    std::atomic<size_t> schedule_turn_{0};  // Lượt hiện tại trong weighted_schedule_
+
+    size_t total_size_ = 0;               // Tổng số Event trong mọi lane (backend Mutex, bảo vệ bởi mutex_)
+    std::atomic<int> sleeping_consumers_{0}; // Số consumer đang ngủ trên condition_ (backend LockFree)
+    std::atomic<bool> closed_{false};     // Cờ đóng hàng đợi, được đặt bởi close()
     mutable std::mutex mutex_;            // Mutex để bảo vệ truy cập vào queue
-    std::condition_variable condition_;   // Biến điều kiện để đồng bộ hóa
+    std::condition_variable condition_;   // Biến điều kiện để đồng bộ hóa (consumer chờ có dữ liệu)
+    std::condition_variable not_full_;    // Producer chờ có chỗ trống (backend Mutex, OverflowPolicy::Block)
+    size_t waiting_producers_ = 0;        // Số producer đang chờ trên not_full_ (bảo vệ bởi mutex_)
+
+    // Bộ đếm cho stats()
+    std::atomic<uint64_t> admitted_{0};
+    std::atomic<uint64_t> blocked_pushes_{0};
+    std::atomic<uint64_t> dropped_newest_{0};
+    std::atomic<uint64_t> dropped_oldest_{0};
+    std::atomic<uint64_t> dropped_sampled_{0};
+    std::atomic<uint64_t> rejected_closed_{0};
 };
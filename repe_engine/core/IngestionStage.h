@@ -0,0 +1,248 @@
+// core/IngestionStage.h
+#pragma once
+
+#include "core/EventProcessor.h"
+#include "core/MpmcRingBuffer.h" // Hàng đợi payload thô không khóa
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>             // Cho std::unique_ptr
+#include <thread>             // Các parser worker
+#include <mutex>              // Cho worker ngủ khi không có payload
+#include <condition_variable>
+#include <atomic>
+#include <functional>         // Cho std::hash
+#include <algorithm>          // Cho std::max
+#include <iostream>
+#include <stdexcept>          // Cho std::invalid_argument
+#include <cstdint>
+
+// IngestionStage tách việc phân tích dữ liệu thô khỏi luồng của InputSource.
+// InputSource chỉ đẩy bộ đệm thô (chuỗi JSON hoặc NDJSON) vào một MpmcRingBuffer; một pool
+// parser worker lấy payload ra, chuyển thành Event qua EventProcessor rồi đẩy vào EventQueue.
+// Nhờ vậy một nguồn dữ liệu nóng (e.g., SocketListener) không còn bị giới hạn bởi một lõi CPU.
+//
+// Thứ tự:
+// - preserve_source_order = false: mọi worker lấy chung một ring buffer, Event của cùng một
+//   nguồn có thể đến EventQueue không theo thứ tự nhận.
+// - preserve_source_order = true: mỗi worker có ring buffer riêng, payload được phân vùng theo
+//   hash của source_id, nên mọi payload của một nguồn do cùng một worker xử lý theo thứ tự.
+//
+// stop() (hoặc destructor) từ chối payload mới, chờ worker xử lý nốt payload còn lại rồi join.
+class IngestionStage {
+public:
+    // Định dạng của payload thô.
+    enum class Format {
+        Json,  // Một JSON object (processRawJsonData)
+        Ndjson // Nhiều JSON object, mỗi dòng một bản ghi (processRawJsonBatch)
+    };
+
+    // Cấu hình của IngestionStage.
+    struct Options {
+        size_t workers = 0;            // Số parser worker; 0 = std::thread::hardware_concurrency()
+        size_t capacity = 1024;        // Số payload tối đa của mỗi ring buffer (lũy thừa của 2)
+        bool preserve_source_order = false;
+    };
+
+    // Bộ đếm của IngestionStage, dùng cho metric và log.
+    struct Stats {
+        uint64_t submitted = 0;       // Số payload được nhận vào hàng đợi thô
+        uint64_t rejected = 0;        // Số payload bị từ chối vì stage đã dừng
+        uint64_t processed = 0;       // Số payload worker đã phân tích xong
+        uint64_t events_admitted = 0; // Số Event worker đẩy được vào EventQueue
+    };
+
+    // Constructor: tạo hàng đợi thô và khởi động các parser worker.
+    // @param processor: EventProcessor dùng để chuyển payload thành Event (được gọi đồng thời từ nhiều worker).
+    // @throws std::invalid_argument nếu capacity không phải lũy thừa của 2.
+    IngestionStage(EventProcessor& processor, const Options& options)
+        : processor_(processor), preserve_source_order_(options.preserve_source_order) {
+        size_t workers = options.workers;
+        if (workers == 0) {
+            workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size_t ring_count = preserve_source_order_ ? workers : 1;
+        for (size_t i = 0; i < ring_count; ++i) {
+            rings_.push_back(std::make_unique<MpmcRingBuffer<RawPayload>>(options.capacity));
+        }
+        for (size_t i = 0; i < workers; ++i) {
+            workers_.emplace_back(&IngestionStage::workerLoop, this, preserve_source_order_ ? i : 0);
+        }
+        std::cout << "[IngestionStage] Started " << workers << " parser workers"
+                  << (preserve_source_order_ ? " (per-source order preserved)." : ".") << std::endl;
+    }
+
+    explicit IngestionStage(EventProcessor& processor) : IngestionStage(processor, Options{}) {}
+
+    ~IngestionStage() { stop(); }
+
+    IngestionStage(const IngestionStage&) = delete;
+    IngestionStage& operator=(const IngestionStage&) = delete;
+
+    // Phương thức submit: Đẩy một payload thô vào hàng đợi của parser worker.
+    // Không phân tích gì trên luồng của caller. Khi hàng đợi thô đầy, caller chờ (yield)
+    // cho đến khi worker giải phóng chỗ — áp lực ngược truyền về InputSource.
+    // @param source_id: Nguồn của payload, cũng là khóa phân vùng khi preserve_source_order.
+    // @param data: Bộ đệm thô (được move vào hàng đợi).
+    // @return true nếu payload được nhận, false nếu stage đã dừng.
+    bool submit(std::string_view source_id, std::string data, Format format = Format::Json) {
+        // Đăng ký trước khi kiểm tra stopping_: worker chỉ thoát khi không còn submit nào dở dang,
+        // nên payload đã được nhận sẽ không bị bỏ lại trong ring buffer khi dừng.
+        active_submitters_.fetch_add(1, std::memory_order_seq_cst);
+        bool accepted = tryEnqueue(source_id, std::move(data), format);
+        active_submitters_.fetch_sub(1, std::memory_order_seq_cst);
+        if (!accepted) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+        wakeSleepingWorkers();
+        return true;
+    }
+
+    // Phương thức stop: Từ chối payload mới, xử lý nốt payload còn lại và join các worker.
+    // Gọi nhiều lần là an toàn.
+    void stop() {
+        if (stopping_.exchange(true)) {
+            return;
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.notify_all();
+        }
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        std::cout << "[IngestionStage] Stopped. Processed " << processed_.load() << " payloads." << std::endl;
+    }
+
+    size_t workerCount() const { return workers_.size(); }
+
+    // Phương thức pending: Số payload đang chờ phân tích (xấp xỉ).
+    size_t pending() const {
+        size_t total = 0;
+        for (const auto& ring : rings_) {
+            total += ring->sizeApprox();
+        }
+        return total;
+    }
+
+    // Phương thức stats: Ảnh chụp các bộ đếm.
+    Stats stats() const {
+        Stats s;
+        s.submitted = submitted_.load(std::memory_order_relaxed);
+        s.rejected = rejected_.load(std::memory_order_relaxed);
+        s.processed = processed_.load(std::memory_order_relaxed);
+        s.events_admitted = events_admitted_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    struct RawPayload {
+        std::string source_id;
+        std::string data;
+        Format format = Format::Json;
+    };
+
+    // Số lần thử tryPop trước khi worker đi ngủ trên condition_.
+    static constexpr int kSpinBeforeSleep = 64;
+
+    bool tryEnqueue(std::string_view source_id, std::string data, Format format) {
+        if (stopping_.load(std::memory_order_seq_cst)) {
+            return false;
+        }
+        RawPayload payload{std::string(source_id), std::move(data), format};
+        MpmcRingBuffer<RawPayload>& ring = *rings_[partitionFor(source_id)];
+        while (!ring.tryPush(payload)) {
+            if (stopping_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    size_t partitionFor(std::string_view source_id) const {
+        if (!preserve_source_order_) {
+            return 0;
+        }
+        return std::hash<std::string_view>{}(source_id) % rings_.size();
+    }
+
+    // Vòng lặp của một parser worker: lấy payload từ ring buffer được giao và phân tích.
+    // Chỉ thoát khi stage đã dừng và ring buffer đã cạn.
+    void workerLoop(size_t ring_index) {
+        MpmcRingBuffer<RawPayload>& ring = *rings_[ring_index];
+        RawPayload payload;
+        int idle_spins = 0;
+        for (;;) {
+            if (ring.tryPop(payload)) {
+                idle_spins = 0;
+                process(payload);
+                continue;
+            }
+            if (stopping_.load(std::memory_order_seq_cst) &&
+                active_submitters_.load(std::memory_order_seq_cst) == 0 && ring.sizeApprox() == 0) {
+                return;
+            }
+            if (++idle_spins < kSpinBeforeSleep) {
+                std::this_thread::yield();
+                continue;
+            }
+            idle_spins = 0;
+            // Đăng ký ngủ trước khi kiểm tra lại ring buffer; fence ghép cặp với wakeSleepingWorkers().
+            sleeping_workers_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [&]{
+                    return ring.sizeApprox() > 0 || stopping_.load(std::memory_order_acquire);
+                });
+            }
+            sleeping_workers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void process(RawPayload& payload) {
+        size_t admitted = 0;
+        if (payload.format == Format::Ndjson) {
+            admitted = processor_.processRawJsonBatch(payload.source_id, payload.data);
+        } else {
+            admitted = processor_.processRawJsonData(payload.source_id, payload.data) ? 1 : 0;
+        }
+        events_admitted_.fetch_add(admitted, std::memory_order_relaxed);
+        processed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Đánh thức worker đang ngủ (nếu có). Với preserve_source_order, chỉ worker sở hữu phân vùng
+    // mới lấy được payload nên đánh thức tất cả; các worker khác kiểm tra ring của mình rồi ngủ lại.
+    void wakeSleepingWorkers() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_workers_.load(std::memory_order_relaxed) > 0) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (preserve_source_order_) {
+                condition_.notify_all();
+            } else {
+                condition_.notify_one();
+            }
+        }
+    }
+
+    EventProcessor& processor_;
+    const bool preserve_source_order_;
+    std::vector<std::unique_ptr<MpmcRingBuffer<RawPayload>>> rings_; // Một ring chung, hoặc một ring mỗi worker
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;                       // Chỉ dùng để worker ngủ/thức
+    std::condition_variable condition_;
+    std::atomic<int> sleeping_workers_{0};
+    std::atomic<bool> stopping_{false};
+    std::atomic<int> active_submitters_{0}; // Số submit() đang chạy (xem stop())
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> events_admitted_{0};
+};
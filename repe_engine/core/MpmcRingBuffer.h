@@ -0,0 +1,125 @@
+// core/MpmcRingBuffer.h
+#pragma once
+
+#include <atomic>     // Cho std::atomic (số thứ tự slot, vị trí đọc/ghi)
+#include <cstddef>    // Cho std::size_t
+#include <cstdint>    // Cho std::intptr_t
+#include <memory>     // Cho std::unique_ptr
+#include <stdexcept>  // Cho std::invalid_argument
+#include <utility>    // Cho std::move
+
+// Kích thước cache line dùng để padding, tránh false sharing giữa các luồng.
+// Không phải trình biên dịch nào cũng cung cấp hardware_destructive_interference_size,
+// nên dùng giá trị 64 byte phổ biến trên x86/ARM.
+inline constexpr std::size_t kCacheLineSize = 64;
+
+// MpmcRingBuffer là một ring buffer có giới hạn, không khóa (lock-free),
+// hỗ trợ nhiều producer và nhiều consumer (MPMC).
+// Mỗi slot mang một số thứ tự (sequence) cho biết slot đang trống hay đã có dữ liệu
+// ở "vòng" hiện tại, nên producer/consumer chỉ cần một CAS trên vị trí ghi/đọc.
+// T phải có default constructor và move assignment (Event thỏa mãn điều này).
+template <typename T>
+class MpmcRingBuffer {
+public:
+    // Constructor: capacity phải là lũy thừa của 2 để dùng phép AND thay cho phép chia lấy dư.
+    // @param capacity: Số slot tối đa của buffer.
+    // @throws std::invalid_argument nếu capacity không phải lũy thừa của 2 hoặc nhỏ hơn 2.
+    explicit MpmcRingBuffer(std::size_t capacity)
+        : mask_(checkedCapacity(capacity) - 1), slots_(new Slot[capacity]) {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueue_pos_.store(0, std::memory_order_relaxed);
+        dequeue_pos_.store(0, std::memory_order_relaxed);
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+    MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+    // tryPush: Cố gắng ghi một phần tử vào buffer mà không chờ.
+    // Phần tử chỉ bị move khi ghi thành công, nên caller có thể thử lại với cùng đối tượng.
+    // @return true nếu ghi thành công, false nếu buffer đầy.
+    bool tryPush(T& item) {
+        Slot* slot;
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                // Slot trống ở vòng này, thử chiếm vị trí ghi.
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Slot vẫn còn dữ liệu của vòng trước: buffer đầy.
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed); // Producer khác đã đi trước, đọc lại.
+            }
+        }
+        slot->value = std::move(item);
+        slot->sequence.store(pos + 1, std::memory_order_release); // Công bố dữ liệu cho consumer.
+        return true;
+    }
+
+    // tryPop: Cố gắng đọc một phần tử từ buffer mà không chờ.
+    // @param out: Nhận phần tử (bằng move) khi đọc thành công.
+    // @return true nếu đọc thành công, false nếu buffer trống.
+    bool tryPop(T& out) {
+        Slot* slot;
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                // Slot đã có dữ liệu, thử chiếm vị trí đọc.
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Chưa có producer nào ghi vào slot này: buffer trống.
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(slot->value);
+        slot->value = T{}; // Giải phóng tài nguyên (chuỗi, map) ngay thay vì giữ đến vòng sau.
+        slot->sequence.store(pos + mask_ + 1, std::memory_order_release); // Trả slot cho vòng ghi tiếp theo.
+        return true;
+    }
+
+    // sizeApprox: Số phần tử xấp xỉ trong buffer.
+    // Chỉ chính xác khi không có push/pop đồng thời; đủ dùng cho log và metric.
+    std::size_t sizeApprox() const {
+        std::size_t enq = enqueue_pos_.load(std::memory_order_acquire);
+        std::size_t deq = dequeue_pos_.load(std::memory_order_acquire);
+        return enq >= deq ? enq - deq : 0;
+    }
+
+    // capacity: Số slot tối đa của buffer.
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    static std::size_t checkedCapacity(std::size_t capacity) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("MpmcRingBuffer capacity must be a power of two >= 2.");
+        }
+        return capacity;
+    }
+
+    // Mỗi slot được căn theo cache line để hai luồng thao tác trên hai slot kề nhau
+    // không làm vô hiệu cache line của nhau.
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    const std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // Vị trí ghi và vị trí đọc nằm trên hai cache line riêng biệt:
+    // producer chỉ tranh chấp enqueue_pos_, consumer chỉ tranh chấp dequeue_pos_.
+    alignas(kCacheLineSize) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> dequeue_pos_{0};
+};
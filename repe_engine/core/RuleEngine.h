@@ -0,0 +1,224 @@
+// core/RuleEngine.h
+#pragma once
+
+#include "core/EventQueue.h"
+#include "common/Event.h"
+#include "common/KeyRegistry.h"
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>      // Cho std::unique_ptr
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>  // Cho std::function, std::hash
+#include <optional>
+#include <variant>     // Cho std::visit khi hash giá trị phân vùng
+#include <type_traits>
+#include <algorithm>   // Cho std::max
+#include <iostream>
+#include <cstdint>
+
+// RuleEngine chạy vòng lặp đánh giá trên N worker thay vì một luồng duy nhất.
+//
+// Event được phân vùng theo hash của một khóa (mặc định Event::source, hoặc giá trị của một key
+// dữ liệu, xem Options::partition_key): mọi Event cùng khóa luôn do cùng một worker xử lý, còn các
+// phân vùng khác nhau được xử lý song song. Thứ tự chỉ được giữ trong từng lane: các Event cùng khóa
+// và cùng lane được xử lý theo thứ tự chúng vào EventQueue đầu vào, còn giữa các lane thì ưu tiên lane
+// thắng (Event lane 0 có thể vượt Event cùng khóa ở lane thấp hơn đến trước nó). Với một lane duy nhất
+// (mặc định), mọi Event cùng khóa được xử lý đúng thứ tự.
+//
+// Với nhiều worker, một luồng router lấy Event từ EventQueue đầu vào theo lô và chia vào hàng đợi
+// riêng của từng worker; khi một worker chậm, hàng đợi của nó đầy và áp lực ngược truyền về EventQueue
+// đầu vào. Hàng đợi worker dùng cùng cấu hình lane với hàng đợi đầu vào và mặc định chỉ chứa khoảng
+// hai lô mỗi lane, nên phần tồn đọng nằm lại ở EventQueue đầu vào, nơi lane ưu tiên được tôn trọng:
+// Event lane 0 không phải xếp sau hàng nghìn Event lane thấp đã được chia cho worker.
+// Với một worker, worker đọc thẳng EventQueue đầu vào (không có router).
+//
+// Việc xử lý mỗi lô (đánh giá quy tắc, dispatch hành động, trả Event về pool) do caller cung cấp
+// qua BatchHandler, được gọi đồng thời từ các worker. RuleManager::evaluate không khóa nên các worker
+// không tranh chấp nhau khi đánh giá.
+//
+// stop() (hoặc destructor) đóng EventQueue đầu vào, chờ mọi Event đã nhận được xử lý xong rồi join.
+class RuleEngine {
+public:
+    // Xử lý một lô Event của một phân vùng trên luồng worker.
+    // Handler được phép lấy (move) Event ra khỏi batch; RuleEngine xóa batch sau khi handler trả về.
+    // @param batch: Các Event theo thứ tự của phân vùng.
+    // @param worker: Chỉ số của worker gọi handler (0..workerCount()-1).
+    using BatchHandler = std::function<void(std::vector<Event>& batch, size_t worker)>;
+
+    // Cấu hình của RuleEngine.
+    struct Options {
+        size_t workers = 0;             // Số worker; 0 = std::thread::hardware_concurrency()
+        std::string partition_key;      // Key dữ liệu dùng để phân vùng; rỗng = Event::source
+        size_t batch_size = 64;         // Số Event tối đa mỗi lần lấy từ hàng đợi
+        // Số Event tối đa chờ trong mỗi lane của hàng đợi worker; 0 = 2 * batch_size
+        size_t worker_queue_capacity = 0;
+        std::chrono::milliseconds idle_timeout{1000}; // Thời gian chờ trước khi kiểm tra lại hàng đợi
+    };
+
+    // Constructor: khởi động router (nếu có nhiều worker) và các worker.
+    // @param input: EventQueue mà các InputSource đẩy Event vào.
+    // @param handler: Xử lý một lô Event trên luồng worker.
+    RuleEngine(EventQueue& input, BatchHandler handler, const Options& options)
+        : input_(input), handler_(std::move(handler)), options_(options) {
+        size_t workers = options_.workers;
+        if (workers == 0) {
+            workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+        options_.batch_size = std::max<size_t>(1, options_.batch_size);
+        if (!options_.partition_key.empty()) {
+            partition_key_id_ = KeyRegistry::intern(options_.partition_key);
+        }
+        processed_ = std::make_unique<std::atomic<uint64_t>[]>(workers);
+        for (size_t i = 0; i < workers; ++i) {
+            processed_[i].store(0, std::memory_order_relaxed);
+        }
+
+        if (workers == 1) {
+            workers_.emplace_back(&RuleEngine::workerLoop, this, std::ref(input_), 0);
+        } else {
+            EventQueue::Options queue_options;
+            queue_options.capacity = options_.worker_queue_capacity > 0 ? options_.worker_queue_capacity
+                                                                        : 2 * options_.batch_size;
+            queue_options.overflow_policy = EventQueue::OverflowPolicy::Block;
+            queue_options.lanes = input_.laneOptions(); // Giữ thứ tự ưu tiên của hàng đợi đầu vào
+            for (size_t i = 0; i < workers; ++i) {
+                worker_queues_.push_back(std::make_unique<EventQueue>(queue_options));
+            }
+            for (size_t i = 0; i < workers; ++i) {
+                workers_.emplace_back(&RuleEngine::workerLoop, this, std::ref(*worker_queues_[i]), i);
+            }
+            router_ = std::thread(&RuleEngine::routerLoop, this);
+        }
+        std::cout << "[RuleEngine] Started " << workers << " workers, partitioned by "
+                  << (options_.partition_key.empty() ? std::string("source") : "key '" + options_.partition_key + "'")
+                  << "." << std::endl;
+    }
+
+    RuleEngine(EventQueue& input, BatchHandler handler) : RuleEngine(input, std::move(handler), Options{}) {}
+
+    ~RuleEngine() { stop(); }
+
+    RuleEngine(const RuleEngine&) = delete;
+    RuleEngine& operator=(const RuleEngine&) = delete;
+
+    // Phương thức stop: Đóng EventQueue đầu vào, xử lý nốt các Event còn lại và join mọi luồng.
+    // Gọi nhiều lần là an toàn.
+    void stop() {
+        if (stopped_.exchange(true)) {
+            return;
+        }
+        input_.close();
+        if (router_.joinable()) {
+            router_.join(); // Router đóng hàng đợi của các worker khi đầu vào đã cạn
+        }
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        std::cout << "[RuleEngine] Stopped. Processed " << processedCount() << " events." << std::endl;
+    }
+
+    size_t workerCount() const { return workers_.size(); }
+
+    // Phương thức partitionFor: Worker sẽ xử lý Event này.
+    // Event không có partition_key được phân vùng theo Event::source.
+    size_t partitionFor(const Event& event) const {
+        if (partition_key_id_) {
+            if (const EventValue* value = event.data.get(*partition_key_id_)) {
+                return hashValue(*value) % workers_.size();
+            }
+        }
+        return std::hash<std::string_view>{}(event.source) % workers_.size();
+    }
+
+    // Số Event mỗi worker đã xử lý.
+    std::vector<uint64_t> processedPerWorker() const {
+        std::vector<uint64_t> counts(workers_.size());
+        for (size_t i = 0; i < counts.size(); ++i) {
+            counts[i] = processed_[i].load(std::memory_order_relaxed);
+        }
+        return counts;
+    }
+
+    uint64_t processedCount() const {
+        uint64_t total = 0;
+        for (uint64_t count : processedPerWorker()) {
+            total += count;
+        }
+        return total;
+    }
+
+private:
+    static size_t hashValue(const EventValue& value) {
+        return std::visit([&value](const auto& arg) -> size_t {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, std::string>) {
+                return std::hash<std::string>{}(arg);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                return std::hash<T>{}(arg);
+            } else {
+                return std::hash<std::string>{}(eventValueToString(value)); // Mảng số, blob
+            }
+        }, value);
+    }
+
+    // Vòng lặp router: chia mỗi lô của hàng đợi đầu vào theo phân vùng, giữ nguyên thứ tự trong phân vùng.
+    void routerLoop() {
+        std::vector<Event> batch;
+        batch.reserve(options_.batch_size);
+        std::vector<std::vector<Event>> routed(worker_queues_.size());
+        for (;;) {
+            batch.clear();
+            size_t count = input_.popBatch(batch, options_.batch_size, options_.idle_timeout);
+            if (count == 0) {
+                if (input_.isClosed()) {
+                    break;
+                }
+                continue;
+            }
+            for (auto& event : batch) {
+                routed[partitionFor(event)].push_back(std::move(event));
+            }
+            for (size_t i = 0; i < routed.size(); ++i) {
+                if (!routed[i].empty()) {
+                    worker_queues_[i]->pushBatch(routed[i]); // Xóa routed[i]
+                }
+            }
+        }
+        for (auto& queue : worker_queues_) {
+            queue->close();
+        }
+    }
+
+    // Vòng lặp worker: lấy lô Event từ hàng đợi được giao và gọi handler.
+    void workerLoop(EventQueue& queue, size_t worker) {
+        std::vector<Event> batch;
+        batch.reserve(options_.batch_size);
+        for (;;) {
+            batch.clear();
+            size_t count = queue.popBatch(batch, options_.batch_size, options_.idle_timeout);
+            if (count == 0) {
+                if (queue.isClosed()) {
+                    break; // Đã đóng và không còn Event nào.
+                }
+                continue;
+            }
+            handler_(batch, worker);
+            processed_[worker].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    EventQueue& input_;
+    BatchHandler handler_;
+    Options options_;
+    std::optional<KeyId> partition_key_id_; // Chỉ có khi Options::partition_key không rỗng
+    std::vector<std::unique_ptr<EventQueue>> worker_queues_; // Rỗng khi chỉ có một worker
+    std::vector<std::thread> workers_;
+    std::thread router_;
+    std::unique_ptr<std::atomic<uint64_t>[]> processed_;
+    std::atomic<bool> stopped_{false};
+};
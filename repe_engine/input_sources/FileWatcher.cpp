@@ -70,6 +70,9 @@ void FileWatcher::watchFile(EventProcessor& processor) {
                             // Sử dụng quá tải processRawJsonData hoặc processRawData tùy thuộc vào file_content_type_
                             if (file_content_type_ == "json_string") {
                                 processor.processRawJsonData("file_watcher/" + path_, current_content);
+                            } else if (file_content_type_ == "ndjson") {
+                                // Mỗi dòng là một bản ghi JSON: cả file được đẩy vào hàng đợi trong một lô
+                                processor.processRawJsonBatch("file_watcher/" + path_, current_content);
                             } else if (file_content_type_ == "string_value") {
                                 // Giả định event_type là "file_content_update" và key là "content"
                                 processor.processRawData("file_watcher/" + path_, "file_content_update", current_content, "content");
@@ -21,13 +21,13 @@ private:
     std::thread worker_thread_; // Separate thread to run the monitoring
     std::atomic<bool> running_; // Flag to control graceful thread shutdown
     std::string last_content_;  // Stores the last read file content to detect changes
-    std::string file_content_type_; // Type of file content (e.g., "json_string", "string_value")
+    std::string file_content_type_; // Type of file content (e.g., "json_string", "ndjson", "string_value")
     std::filesystem::file_time_type last_write_time_; // Last write time of the file
 
 public:
     // Constructor for FileWatcher
     // @param path: The path to the file to monitor.
-    // @param content_type: The type of data in the file content (e.g., "json_string", "string_value").
+    // @param content_type: The type of data in the file content (e.g., "json_string", "ndjson", "string_value").
     FileWatcher(const std::string& path, const std::string& content_type);
 
     // start() method: Starts monitoring the file in a separate thread.
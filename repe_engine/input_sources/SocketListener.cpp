@@ -1,13 +1,16 @@
 // input_sources/SocketListener.cpp
 #include "SocketListener.h" // Include the header for SocketListener
 #include "core/EventProcessor.h" // Include EventProcessor to use it
+#include "core/IngestionStage.h" // Optional parallel parsing stage
 #include <chrono> // For std::chrono::seconds, std::this_thread::sleep_for
 #include <iostream> // For std::cout
 
 // Constructor for SocketListener.
 // Initializes the port and sets the running flag to false.
 // @param port: The network port that the listener will bind to.
-SocketListener::SocketListener(int port) : port_(port), running_(false) {}
+// @param ingestion_stage: Optional stage that parses payloads on its worker pool.
+SocketListener::SocketListener(int port, IngestionStage* ingestion_stage)
+    : port_(port), running_(false), ingestion_stage_(ingestion_stage) {}
 
 // Starts the socket listener in a separate thread.
 // @param processor: Reference to the EventProcessor to send received data.
@@ -60,10 +63,19 @@ void SocketListener::listenSocket(EventProcessor& processor) {
 
         if (running_) { // Check the running flag again after sleeping.
                         // This ensures no data is processed if `stop()` was called during the sleep.
-            std::string dummy_data = R"({"type": "network_data", "client_ip": "127.0.0.1", "bytes_received": 1024, "protocol": "TCP"})";
+            // A single recv() usually returns several newline-delimited JSON records.
+            std::string dummy_data =
+                R"({"type": "network_data", "client_ip": "127.0.0.1", "bytes_received": 1024, "protocol": "TCP"})" "\n"
+                R"({"type": "network_data", "client_ip": "127.0.0.2", "bytes_received": 512, "protocol": "TCP"})" "\n";
             std::cout << "[SocketListener] (Simulated) Received data. Processing..." << std::endl;
-            // Assume the received data is a JSON string and pass it to the EventProcessor.
-            processor.processRawJsonData("socket_listener/" + std::to_string(port_), dummy_data);
+            std::string source_id = "socket_listener/" + std::to_string(port_);
+            if (ingestion_stage_) {
+                // Hand the raw buffer off; parsing happens on the ingestion stage's workers.
+                ingestion_stage_->submit(source_id, std::move(dummy_data), IngestionStage::Format::Ndjson);
+            } else {
+                // Hand the whole payload to the EventProcessor so all records reach the queue in one batch.
+                processor.processRawJsonBatch(source_id, dummy_data);
+            }
         }
     }
 }
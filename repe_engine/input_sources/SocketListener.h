@@ -9,6 +9,7 @@
 
 // Forward declaration của EventProcessor
 class EventProcessor;
+class IngestionStage;
 
 // SocketListener là một InputSource cụ thể, lắng nghe các kết nối socket.
 // Nó triển khai IInputStrategy (Strategy Pattern).
@@ -20,11 +21,14 @@ private:
     int port_;                  // Cổng để lắng nghe
     std::thread worker_thread_; // Luồng riêng để chạy việc lắng nghe socket
     std::atomic<bool> running_; // Cờ để kiểm soát việc dừng luồng
+    IngestionStage* ingestion_stage_; // Nếu khác nullptr: payload thô được giao cho parser worker
 
 public:
     // Constructor của SocketListener
     // @param port: Cổng mạng mà listener sẽ lắng nghe.
-    SocketListener(int port);
+    // @param ingestion_stage: IngestionStage tùy chọn. Khi có, luồng lắng nghe chỉ đẩy bộ đệm thô
+    //                         vào stage, việc phân tích JSON diễn ra trên các parser worker.
+    SocketListener(int port, IngestionStage* ingestion_stage = nullptr);
 
     // Phương thức start(): Bắt đầu lắng nghe socket trong một luồng riêng.
     // @param processor: Tham chiếu đến EventProcessor để gửi dữ liệu đã nhận.
@@ -1,6 +1,9 @@
 // main.cpp
 #include "core/EventQueue.h"
 #include "core/EventProcessor.h"
+#include "core/EventPool.h"
+#include "core/IngestionStage.h"
+#include "core/RuleEngine.h"
 #include "input_sources/FileWatcher.h"
 #include "input_sources/SocketListener.h"
 #include "input_sources/RestApiEndpoint.h"
@@ -13,49 +16,41 @@
 #include <fstream>   // For creating dummy data files
 #include <thread>    // For std::thread
 #include <chrono>    // For std::chrono
-#include <atomic>    // For atomic flag to stop RuleEngine thread
 #include <limits>    // For std::numeric_limits
+#include <vector>    // For the batched RuleEngine loop
 
 // Declare the function to register all default actions.
 // This function is defined in actions/ActionFactory.cpp.
 extern void registerAllDefaultActions();
 
-// Atomic flag to control the main loop of the RuleEngine thread.
-// It allows for graceful shutdown of the thread.
-std::atomic<bool> rule_engine_running(true);
-
-// Function to run the Rule Engine in a separate thread.
-// It continuously pops events from the EventQueue, evaluates them against rules,
-// and dispatches actions if rules match.
-// @param event_queue: Reference to the EventQueue from which to retrieve events.
+// Batch handler for the multi-worker RuleEngine (core/RuleEngine.h).
+// Each call receives up to RuleEngine::Options::batch_size events of one partition, in order.
+// It evaluates the whole batch through RuleManager (one lock-free RuleSet snapshot per batch),
+// then dispatches the triggered actions. Under bursty load this amortizes the queue
+// locking over the whole batch instead of paying it per event.
+// Processed events are handed back to the EventPool in bulk so producers can reuse them.
+// A matched event is instead moved into a pooled snapshot (EventPool::share) shared by all its actions;
+// it returns to the pool once the last of those actions has run.
+// @param batch: Events of one partition, in arrival order.
+// @param worker: Index of the RuleEngine worker running this batch (for logging).
 // @param action_dispatcher: Reference to the ActionDispatcher to dispatch triggered actions.
-void runRuleEngine(EventQueue& event_queue, ActionDispatcher& action_dispatcher) {
-    while (rule_engine_running) { // Loop as long as the rule_engine_running flag is true.
-        std::cout << "\n[RuleEngine Thread] Waiting for event from queue..." << std::endl;
-        // Use tryPop() to avoid blocking indefinitely when shutting down.
-        // If the queue is empty, it returns std::nullopt.
-        std::optional<Event> opt_event = event_queue.tryPop();
-
-        if (opt_event) { // Check if an event was successfully retrieved.
-            Event event = std::move(opt_event.value()); // Move the event out of optional.
-            std::cout << "[RuleEngine Thread] Received event:\n" << event.toString() << std::endl;
-
-            // Evaluate the event against all loaded rules using the RuleManager.
-            std::vector<nlohmann::json> triggered_actions = RuleManager::getInstance().evaluate(event);
-
-            // Dispatch any actions that were triggered by matching rules.
-            if (!triggered_actions.empty()) {
-                std::cout << "[RuleEngine Thread] Dispatching " << triggered_actions.size() << " actions for event ID: " << event.id << std::endl;
-                action_dispatcher.dispatch(triggered_actions, event);
-            } else {
-                std::cout << "[RuleEngine Thread] No rules matched for event ID: " << event.id << std::endl;
-            }
+// @param event_pool: Pool the producers acquire events from.
+void processRuleEngineBatch(std::vector<Event>& batch, size_t worker, ActionDispatcher& action_dispatcher, EventPool& event_pool) {
+    std::cout << "\n[RuleEngine Worker " << worker << "] Received batch of " << batch.size() << " events." << std::endl;
+
+    // Evaluate the whole batch before dispatching anything.
+    std::vector<std::vector<ActionCommandRef>> triggered_actions = RuleManager::getInstance().evaluateBatch(batch);
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Event& event = batch[i];
+        if (!triggered_actions[i].empty()) {
+            std::cout << "[RuleEngine Worker " << worker << "] Dispatching " << triggered_actions[i].size() << " actions for event ID: " << formatEventId(event.id) << std::endl;
+            action_dispatcher.dispatch(triggered_actions[i], event_pool.share(std::move(event)));
         } else {
-            // If the queue is empty, pause briefly to prevent a busy-wait loop.
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            std::cout << "[RuleEngine Worker " << worker << "] No rules matched for event ID: " << formatEventId(event.id) << std::endl;
         }
     }
-    std::cout << "[RuleEngine Thread] Stopped." << std::endl;
+    event_pool.releaseBatch(batch); // Return the unmatched events for reuse (also clears the batch).
 }
 
 int main() {
@@ -64,9 +59,37 @@ int main() {
     registerAllDefaultActions();
 
     // 2. Initialize core components of the REPE system.
-    EventQueue event_queue;             // The thread-safe queue for events.
-    EventProcessor event_processor(event_queue); // Processes raw data into Events and pushes to queue.
-    ActionDispatcher action_dispatcher; // Dispatches actions to be executed.
+    // The thread-safe queue for events. It is bounded so a burst from a chatty source
+    // cannot grow memory without limit; when full, producers wait for the RuleEngine.
+    // Manual operator input goes to the high-priority lane so it is never stuck behind
+    // a backlog of sensor/socket traffic; periodic heartbeats go to the lowest lane.
+    EventQueue::Options queue_options;
+    queue_options.backend = EventQueue::Backend::Mutex;
+    queue_options.capacity = 8192;
+    queue_options.overflow_policy = EventQueue::OverflowPolicy::Block;
+    queue_options.lanes.count = 3;
+    queue_options.lanes.by_source_prefix = {{"manual_", 0}};
+    queue_options.lanes.by_type = {{"heartbeat", 2}};
+    queue_options.lanes.default_lane = 1;
+    EventQueue event_queue(queue_options);
+    EventPool event_pool; // Recycles Event objects between the RuleEngine and the producers.
+    EventProcessor event_processor(event_queue, &event_pool); // Processes raw data into Events and pushes to queue.
+    // Parser worker pool for network payloads: the socket thread only enqueues raw buffers,
+    // so JSON parsing scales with cores. Per-source order is kept for the rules that rely on it.
+    IngestionStage::Options ingestion_options;
+    ingestion_options.preserve_source_order = true;
+    IngestionStage ingestion_stage(event_processor, ingestion_options);
+    // Dispatches actions to be executed, on one bulkheaded executor per action type:
+    // hanging shell commands or slow HTTP endpoints can only exhaust their own threads and queue,
+    // so log alerts keep their latency. When a bounded queue is full, further actions of that type are dropped.
+    ActionDispatcher::Options dispatcher_options;
+    dispatcher_options.default_executor = {"default", 1, 0, {}};
+    dispatcher_options.executors = {
+        {"alerts", 2, 0, {"log"}},
+        {"http", 4, 1024, {"http"}},
+        {"shell", 2, 64, {"shell"}},
+    };
+    ActionDispatcher action_dispatcher(dispatcher_options);
 
     // 3. Prepare a dummy rules configuration file (rules.json).
     // This file defines the rules that the RuleEngine will load and evaluate.
@@ -119,12 +142,18 @@ int main() {
 
     // 4. Load the rules into the RuleManager.
     // This makes the rules available for evaluation by the RuleEngine thread.
+    // The demo rules share tests (e.g. location == "LivingRoom"), so evaluate them through the alpha network.
+    RuleManager::getInstance().setEvaluationMode(RuleManager::EvaluationMode::AlphaNetwork);
     try {
         RuleManager::getInstance().loadRules("rules.json");
     } catch (const std::exception& e) {
         std::cerr << "ERROR loading rules: " << e.what() << ". Exiting." << std::endl;
         return 1; // Exit if rules cannot be loaded.
     }
+    // Let the EventProcessor drop events no loaded rule can match (refreshed on every loadRules).
+    RuleManager::getInstance().subscribeIngestFilter([&event_processor](std::shared_ptr<const IngestFilter> filter) {
+        event_processor.setIngestFilter(std::move(filter));
+    });
 
     // 5. Initialize and start various InputSources.
     // These sources will generate raw data and send it to the EventProcessor.
@@ -144,7 +173,7 @@ int main() {
     FileWatcher text_file_watcher("system_status.txt", "string_value"); // Assumes the entire file content is a single string value.
     text_file_watcher.start(event_processor);
 
-    SocketListener socket_listener(12345); // Skeleton: Simulates receiving data on port 12345.
+    SocketListener socket_listener(12345, &ingestion_stage); // Skeleton: Simulates receiving data on port 12345.
     socket_listener.start(event_processor);
 
     RestApiEndpoint rest_api_endpoint(8080); // Skeleton: Simulates receiving API requests on port 8080.
@@ -153,9 +182,14 @@ int main() {
     TimerScheduler timer_scheduler(std::chrono::seconds(7), "heartbeat", "System heartbeat check.");
     timer_scheduler.start(event_processor);
 
-    // 6. Run the Rule Engine in a separate thread.
-    // This thread will continuously process events from the queue.
-    std::thread rule_engine_worker(runRuleEngine, std::ref(event_queue), std::ref(action_dispatcher));
+    // 6. Run the Rule Engine on one worker per core.
+    // Events are partitioned by source, so events of one source are evaluated in order on one worker
+    // while different sources are evaluated in parallel, in micro-batches.
+    RuleEngine::Options engine_options;
+    engine_options.batch_size = 64;
+    RuleEngine rule_engine(event_queue, [&action_dispatcher, &event_pool](std::vector<Event>& batch, size_t worker) {
+        processRuleEngineBatch(batch, worker, action_dispatcher, event_pool);
+    }, engine_options);
 
     // 7. Main application loop (waits for a stop command).
     std::cout << "\nREPE system running. Enter 'temp' to input temperature, 'status' for system status, or 'q' to quit..." << std::endl;
@@ -187,20 +221,26 @@ int main() {
 
     // 8. Graceful shutdown of the system.
     std::cout << "Stopping REPE system..." << std::endl;
-    rule_engine_running = false; // Signal the RuleEngine thread to stop.
 
-    // Stop all InputSources.
+    // Stop all InputSources first. The RuleEngine keeps consuming meanwhile, so producers blocked
+    // on a full queue are released and nothing they already produced is rejected.
     json_file_watcher.stop();
     text_file_watcher.stop();
     socket_listener.stop();
     rest_api_endpoint.stop();
     timer_scheduler.stop();
+    ingestion_stage.stop(); // Parse whatever the socket already handed off, then join the workers.
 
-    // Ensure the RuleEngine thread finishes its execution.
-    if (rule_engine_worker.joinable()) {
-        rule_engine_worker.join();
-    }
+    // Only now close the event queue (RuleEngine::stop() does it) and let the RuleEngine workers
+    // finish evaluating every queued event.
+    rule_engine.stop();
 
+    std::cout << "Events filtered at ingest (no rule could match): " << event_processor.filteredCount() << std::endl;
+    for (const auto& stats : action_dispatcher.executorStats()) {
+        std::cout << "Action executor '" << stats.name << "': " << stats.submitted << " submitted, " << stats.rejected
+                  << " rejected, queue depth " << stats.queue_depth << ", " << stats.active << "/" << stats.threads
+                  << " threads busy." << std::endl;
+    }
     std::cout << "REPE system stopped." << std::endl;
 
     return 0;
@@ -0,0 +1,164 @@
+// rules/AlphaNetwork.cpp
+#include "AlphaNetwork.h"
+#include <map> // Gom phép thử theo key khi tạo mạng
+
+namespace {
+
+using OpCode = ConditionProgram::OpCode;
+
+// Các phép thử khác nhau của mỗi key, theo thứ tự gặp lần đầu.
+using TestsByKey = std::map<KeyId, std::vector<ValueComparison>>;
+
+// Vị trí của phép thử trong danh sách của key, thêm mới nếu chưa có.
+uint32_t internTest(TestsByKey& tests, KeyId key, const ValueComparison& comparison) {
+    std::vector<ValueComparison>& key_tests = tests[key];
+    for (size_t i = 0; i < key_tests.size(); ++i) {
+        if (key_tests[i] == comparison) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    key_tests.push_back(comparison);
+    return static_cast<uint32_t>(key_tests.size() - 1);
+}
+
+// Gọi visit(key, comparison) cho mỗi cặp LoadKey/CompareConst của chương trình.
+// Trả về false nếu chương trình có dạng khác (quy tắc khi đó được đánh giá bằng Rule::check).
+template <typename Visitor>
+bool forEachTest(const ConditionProgram& program, Visitor&& visit) {
+    const auto& code = program.code();
+    for (size_t pc = 0; pc < code.size(); ++pc) {
+        if (code[pc].op == OpCode::CompareConst) {
+            return false; // CompareConst không đi sau LoadKey
+        }
+        if (code[pc].op != OpCode::LoadKey) {
+            continue;
+        }
+        if (pc + 1 >= code.size() || code[pc + 1].op != OpCode::CompareConst) {
+            return false;
+        }
+        visit(code[pc].arg, program.constants()[code[pc + 1].arg]);
+        ++pc;
+    }
+    return true;
+}
+
+} // namespace
+
+// Constructor: Tạo mạng qua hai lượt: gom các phép thử khác nhau của mọi quy tắc, xếp chúng theo key,
+// rồi viết lại chương trình của từng quy tắc để mỗi phép thử đọc alpha node dùng chung.
+AlphaNetwork::AlphaNetwork(const std::vector<Rule>& rules) {
+    TestsByKey tests;
+    std::vector<bool> shareable(rules.size(), false);
+    for (size_t i = 0; i < rules.size(); ++i) {
+        const ConditionProgram* program = rules[i].getProgram();
+        if (!program) {
+            continue;
+        }
+        size_t rule_tests = 0;
+        shareable[i] = forEachTest(*program, [&](KeyId key, const ValueComparison& comparison) {
+            internTest(tests, key, comparison);
+            ++rule_tests;
+        });
+        if (shareable[i]) {
+            test_count_ += rule_tests;
+        }
+    }
+
+    // Xếp các node theo key để mỗi key của Event ứng với một khoảng liên tục.
+    std::map<KeyId, uint32_t> first_node;
+    for (const auto& [key, key_tests] : tests) {
+        first_node[key] = static_cast<uint32_t>(nodes_.size());
+        if (key >= key_ranges_.size()) {
+            key_ranges_.resize(static_cast<size_t>(key) + 1);
+        }
+        key_ranges_[key].begin = static_cast<uint32_t>(nodes_.size());
+        for (const auto& comparison : key_tests) {
+            nodes_.push_back(AlphaNode{key, comparison});
+        }
+        key_ranges_[key].end = static_cast<uint32_t>(nodes_.size());
+    }
+
+    beta_programs_.resize(rules.size());
+    for (size_t i = 0; i < rules.size(); ++i) {
+        if (shareable[i]) {
+            const auto& code = rules[i].getProgram()->code();
+            const auto& constants = rules[i].getProgram()->constants();
+            auto beta = std::make_unique<ConditionProgram>();
+            // Mỗi cặp LoadKey/CompareConst thành một TestAlpha nên đích nhảy bị dịch chuyển.
+            std::vector<uint32_t> new_position(code.size() + 1);
+            std::vector<uint32_t> jumps;
+            for (size_t pc = 0; pc < code.size(); ++pc) {
+                new_position[pc] = beta->nextPosition();
+                const ConditionProgram::Instruction& instruction = code[pc];
+                if (instruction.op == OpCode::LoadKey) {
+                    const ValueComparison& comparison = constants[code[pc + 1].arg];
+                    uint32_t node = first_node[instruction.arg] + internTest(tests, instruction.arg, comparison);
+                    beta->emit(OpCode::TestAlpha, node);
+                    new_position[pc + 1] = new_position[pc];
+                    ++pc;
+                    continue;
+                }
+                uint32_t at = beta->emit(instruction.op, instruction.arg);
+                if (instruction.op == OpCode::JumpIfFalse || instruction.op == OpCode::JumpIfTrue) {
+                    jumps.push_back(at);
+                }
+            }
+            new_position[code.size()] = beta->nextPosition();
+            for (uint32_t at : jumps) {
+                beta->patchJump(at, new_position[beta->code()[at].arg]);
+            }
+            beta_programs_[i] = std::move(beta);
+        }
+    }
+}
+
+// Phương thức evaluateAlphaNodes: Tính các alpha node có key trong Event; node có key vắng mặt là false.
+const uint8_t* AlphaNetwork::evaluateAlphaNodes(const Event& event) const {
+    thread_local std::vector<uint8_t> alpha_memory;
+    alpha_memory.assign(nodes_.size(), 0);
+    for (const auto& [key, value] : event.data) {
+        if (key >= key_ranges_.size()) {
+            continue;
+        }
+        const KeyRange& range = key_ranges_[key];
+        for (uint32_t node = range.begin; node < range.end; ++node) {
+            alpha_memory[node] = nodes_[node].comparison(value) ? 1 : 0;
+        }
+    }
+    return alpha_memory.data();
+}
+
+// Chạy chương trình của một quy tắc trên alpha memory (hoặc Rule::check nếu quy tắc không dùng mạng).
+bool AlphaNetwork::fires(const std::vector<Rule>& rules, size_t rule_index, const Event& event,
+                         const uint8_t* alpha_memory) const {
+    const Rule& rule = rules[rule_index];
+    const ConditionProgram* program = beta_programs_[rule_index].get();
+    if (!program) {
+        return rule.check(event);
+    }
+    return rule.getCondition() != nullptr && rule.matchesScope(event) && program->run(event, alpha_memory);
+}
+
+// Phương thức match: Tính alpha memory một lần, rồi chạy chương trình của từng quy tắc trên đó.
+void AlphaNetwork::match(const std::vector<Rule>& rules, const Event& event, std::vector<size_t>& matched) const {
+    const uint8_t* alpha_memory = evaluateAlphaNodes(event);
+    for (size_t i = 0; i < beta_programs_.size(); ++i) {
+        if (fires(rules, i, event, alpha_memory)) {
+            matched.push_back(i);
+        }
+    }
+}
+
+void AlphaNetwork::match(const std::vector<Rule>& rules, const Event& event, const std::vector<size_t>& candidates,
+                         std::vector<size_t>& matched) const {
+    const uint8_t* alpha_memory = evaluateAlphaNodes(event);
+    for (size_t rule_index : candidates) {
+        if (fires(rules, rule_index, event, alpha_memory)) {
+            matched.push_back(rule_index);
+        }
+    }
+}
+
+const ConditionProgram* AlphaNetwork::getBetaProgram(size_t rule_index) const {
+    return rule_index < beta_programs_.size() ? beta_programs_[rule_index].get() : nullptr;
+}
@@ -0,0 +1,67 @@
+// rules/AlphaNetwork.h
+#pragma once
+
+#include "rules/Rule.h"
+#include "common/Event.h"
+#include "rules/conditions/ConditionProgram.h"
+#include "rules/conditions/ValueComparison.h"
+#include <cstdint>
+#include <memory> // Cho std::unique_ptr
+#include <vector>
+
+// AlphaNetwork là dạng biên dịch của cả bộ quy tắc theo kiểu mạng alpha của Rete.
+//
+// Mỗi phép thử (key, toán tử, hằng số) khác nhau trong toàn bộ quy tắc trở thành một alpha node
+// duy nhất, dù bao nhiêu quy tắc dùng nó (e.g., location == "LivingRoom"). Với mỗi Event:
+// 1. Chỉ các alpha node có key xuất hiện trong Event được tính, mỗi node đúng một lần,
+//    kết quả ghi vào alpha memory (một byte mỗi node; key vắng mặt cho false).
+// 2. Mỗi quy tắc chạy một ConditionProgram trong đó mọi cặp LoadKey/CompareConst đã được
+//    thay bằng TestAlpha, tức là chỉ đọc và kết hợp các byte của alpha memory.
+// Chi phí so sánh giá trị vì vậy tăng theo số phép thử khác nhau, không theo số quy tắc × điều kiện.
+//
+// Quy tắc không biên dịch được thành bytecode vẫn được đánh giá bằng Rule::check.
+// AlphaNetwork chỉ giữ chỉ số của quy tắc; caller phải dùng cùng vector<Rule> đã tạo ra nó.
+class AlphaNetwork {
+public:
+    // Constructor: Gộp các phép thử của mọi quy tắc và biên dịch lại điều kiện của từng quy tắc.
+    explicit AlphaNetwork(const std::vector<Rule>& rules);
+
+    // Phương thức match: Tìm các quy tắc khớp với Event.
+    // @param rules: Vector quy tắc đã dùng để tạo AlphaNetwork.
+    // @param matched: Nhận chỉ số của các quy tắc khớp, theo thứ tự trong rules.
+    void match(const std::vector<Rule>& rules, const Event& event, std::vector<size_t>& matched) const;
+
+    // Như trên, nhưng chỉ xét các quy tắc trong candidates (tăng dần, e.g., từ RuleIndex::candidates).
+    void match(const std::vector<Rule>& rules, const Event& event, const std::vector<size_t>& candidates,
+               std::vector<size_t>& matched) const;
+
+    // Số alpha node (số phép thử khác nhau) của bộ quy tắc.
+    size_t alphaNodeCount() const { return nodes_.size(); }
+
+    // Tổng số phép thử trong các quy tắc trước khi gộp.
+    size_t testCount() const { return test_count_; }
+
+    // Chương trình của một quy tắc sau khi thay phép thử bằng TestAlpha (nullptr nếu quy tắc dùng Rule::check).
+    const ConditionProgram* getBetaProgram(size_t rule_index) const;
+
+private:
+    // Tính alpha memory cho Event (dùng chung bởi hai overload của match).
+    const uint8_t* evaluateAlphaNodes(const Event& event) const;
+    bool fires(const std::vector<Rule>& rules, size_t rule_index, const Event& event, const uint8_t* alpha_memory) const;
+
+    struct AlphaNode {
+        KeyId key;
+        ValueComparison comparison;
+    };
+
+    // Khoảng [begin, end) của các alpha node cùng một key trong nodes_.
+    struct KeyRange {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+
+    std::vector<AlphaNode> nodes_;        // Sắp xếp theo key
+    std::vector<KeyRange> key_ranges_;    // Đánh chỉ số theo KeyId
+    std::vector<std::unique_ptr<ConditionProgram>> beta_programs_; // Một mục cho mỗi quy tắc; nullptr: dùng Rule::check
+    size_t test_count_ = 0;
+};
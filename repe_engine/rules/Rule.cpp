@@ -1,5 +1,8 @@
 // rules/Rule.cpp
 #include "Rule.h" // Bao gồm file header của lớp Rule
+#include "actions/ActionFactory.h" // Tạo hành động từ cấu hình khi tải quy tắc
+#include <stdexcept> // For std::runtime_error
+#include <algorithm> // For std::find, std::none_of, std::sort, std::unique
 
 // Constructor của Rule
 // Chuyển quyền sở hữu của unique_ptr<ICondition> và vector<nlohmann::json> bằng std::move
@@ -7,6 +10,42 @@
 Rule::Rule(const std::string& id, std::unique_ptr<ICondition> cond, std::vector<nlohmann::json> actions)
     : id_(id), condition_root_(std::move(cond)), actions_config_(std::move(actions)) {}
 
+// Phương thức setScope: Giới hạn quy tắc cho một số type và/hoặc tiền tố nguồn Event.
+void Rule::setScope(std::vector<std::string> event_types, std::vector<std::string> source_prefixes) {
+    event_types_ = std::move(event_types);
+    source_prefixes_ = std::move(source_prefixes);
+}
+
+// Phương thức compile: Biên dịch cây điều kiện thành bytecode.
+// Chương trình chỉ được giữ lại nếu mọi node của cây đều biên dịch được.
+bool Rule::compile() {
+    program_.reset();
+    if (!condition_root_) {
+        return false;
+    }
+    auto program = std::make_unique<ConditionProgram>();
+    if (!condition_root_->compile(*program)) {
+        return false;
+    }
+    program->emit(ConditionProgram::OpCode::Return);
+    program_ = std::move(program);
+    return true;
+}
+
+// Phương thức buildActions: Tạo mọi hành động của quy tắc; chỉ thay actions_ khi tất cả đều tạo được.
+void Rule::buildActions() {
+    std::vector<ActionCommandRef> actions;
+    actions.reserve(actions_config_.size());
+    for (const auto& action_cfg : actions_config_) {
+        try {
+            actions.push_back(ActionFactory::createAction(action_cfg));
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Rule '" + id_ + "' has an invalid action: " + e.what());
+        }
+    }
+    actions_ = std::move(actions);
+}
+
 // Phương thức check: Đánh giá điều kiện của quy tắc dựa trên một Event.
 // @param event: Đối tượng Event cần được đánh giá.
 // @return true nếu điều kiện của quy tắc được đáp ứng, ngược lại false.
@@ -16,19 +55,82 @@ bool Rule::check(const Event& event) const {
     if (!condition_root_) {
         return false;
     }
+    // Quy tắc có phạm vi (type/nguồn) chỉ áp dụng cho Event thuộc phạm vi đó.
+    if (!matchesScope(event)) {
+        return false;
+    }
+    // Đường nhanh: chạy bytecode liên tục trong bộ nhớ, không gọi hàm ảo.
+    if (program_) {
+        return program_->run(event);
+    }
     // Gọi phương thức evaluate trên gốc của cây điều kiện (ICondition)
     // để thực hiện việc đánh giá điều kiện một cách đệ quy.
     return condition_root_->evaluate(event);
 }
 
+// Phương thức matchesScope: Kiểm tra Event::type và tiền tố Event::source theo phạm vi của quy tắc.
+bool Rule::matchesScope(const Event& event) const {
+    if (!event_types_.empty() &&
+        std::find(event_types_.begin(), event_types_.end(), event.type) == event_types_.end()) {
+        return false;
+    }
+    if (!source_prefixes_.empty() &&
+        std::none_of(source_prefixes_.begin(), source_prefixes_.end(), [&](const std::string& prefix) {
+            return event.source.compare(0, prefix.size(), prefix) == 0;
+        })) {
+        return false;
+    }
+    return true;
+}
+
 // Phương thức getActionsConfig: Trả về một tham chiếu const đến vector chứa cấu hình của các hành động.
 // @return Tham chiếu const đến vector cấu hình hành động (nlohmann::json).
 const std::vector<nlohmann::json>& Rule::getActionsConfig() const {
     return actions_config_;
 }
 
+const std::vector<ActionCommandRef>& Rule::getActions() const {
+    return actions_;
+}
+
 // Phương thức getId: Trả về ID của quy tắc.
 // @return Tham chiếu const đến chuỗi ID của quy tắc.
 const std::string& Rule::getId() const {
     return id_;
 }
+
+const ICondition* Rule::getCondition() const {
+    return condition_root_.get();
+}
+
+const ConditionProgram* Rule::getProgram() const {
+    return program_.get();
+}
+
+const std::vector<std::string>& Rule::getEventTypes() const {
+    return event_types_;
+}
+
+const std::vector<std::string>& Rule::getSourcePrefixes() const {
+    return source_prefixes_;
+}
+
+// Phương thức collectRequiredKeys: Key bắt buộc của cây điều kiện.
+// Quy tắc không có điều kiện không bao giờ khớp, nên tập key rỗng là chính xác.
+bool Rule::collectRequiredKeys(std::vector<KeyId>& keys) const {
+    if (!condition_root_) {
+        return true;
+    }
+    return condition_root_->collectRequiredKeys(keys);
+}
+
+// Phương thức collectMandatoryKeys: Key bắt buộc của cây điều kiện, đã sắp xếp và loại trùng.
+std::vector<KeyId> Rule::collectMandatoryKeys() const {
+    std::vector<KeyId> keys;
+    if (condition_root_) {
+        condition_root_->collectMandatoryKeys(keys);
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
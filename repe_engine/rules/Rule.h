@@ -7,6 +7,8 @@
 #include <nlohmann/json.hpp> // For action configuration (nlohmann::json)
 
 #include "ICondition.h" // Bao gồm interface điều kiện
+#include "ConditionProgram.h" // Dạng bytecode của cây điều kiện
+#include "actions/IActionCommand.h" // Hành động đã tạo sẵn của quy tắc (ActionCommandRef)
 
 // Lớp Rule biểu diễn một quy tắc duy nhất trong hệ thống.
 // Mỗi quy tắc có một ID, một điều kiện gốc (dạng cây) và một danh sách các hành động.
@@ -14,7 +16,11 @@ class Rule {
 private:
     std::string id_;                        // ID duy nhất của quy tắc
     std::unique_ptr<ICondition> condition_root_; // Gốc của cây điều kiện (Interpreter Pattern)
+    std::unique_ptr<ConditionProgram> program_;  // Bytecode của cây điều kiện (nullptr nếu không biên dịch được)
     std::vector<nlohmann::json> actions_config_; // Cấu hình của các hành động cần thực thi khi quy tắc khớp
+    std::vector<ActionCommandRef> actions_;      // Hành động tạo từ actions_config_ (xem buildActions)
+    std::vector<std::string> event_types_;       // Event::type được chấp nhận (rỗng = mọi type)
+    std::vector<std::string> source_prefixes_;   // Tiền tố Event::source được chấp nhận (rỗng = mọi nguồn)
 
 public:
     // Constructor của Rule.
@@ -23,16 +29,53 @@ public:
     // @param actions: Vector chứa cấu hình JSON của các hành động.
     Rule(const std::string& id, std::unique_ptr<ICondition> cond, std::vector<nlohmann::json> actions);
 
+    // Phương thức setScope: Giới hạn quy tắc cho một số type và/hoặc nguồn Event.
+    // @param event_types: Các Event::type được chấp nhận (rỗng = mọi type).
+    // @param source_prefixes: Các tiền tố Event::source được chấp nhận (rỗng = mọi nguồn).
+    void setScope(std::vector<std::string> event_types, std::vector<std::string> source_prefixes);
+
+    // Phương thức compile: Biên dịch cây điều kiện thành ConditionProgram.
+    // Nếu có điều kiện không hỗ trợ biên dịch, quy tắc tiếp tục được đánh giá bằng cây.
+    // @return true nếu biên dịch thành công.
+    bool compile();
+
+    // Phương thức buildActions: Tạo các IActionCommand từ cấu hình hành động qua ActionFactory.
+    // Được gọi một lần khi tải quy tắc, để đánh giá và dispatch không phải tạo lại hành động cho mỗi Event.
+    // @throws std::runtime_error nếu một cấu hình hành động không hợp lệ hoặc loại hành động chưa được đăng ký.
+    void buildActions();
+
     // Phương thức check: Đánh giá xem một Event có khớp với điều kiện của quy tắc không.
+    // Dùng ConditionProgram nếu đã biên dịch, nếu không thì duyệt cây điều kiện.
     // @param event: Event cần được đánh giá.
     // @return true nếu điều kiện của quy tắc được đáp ứng, ngược lại false.
     bool check(const Event& event) const;
 
+    // Phương thức matchesScope: Event có thuộc phạm vi (type/nguồn) của quy tắc không.
+    bool matchesScope(const Event& event) const;
+
     // Phương thức getActionsConfig: Trả về một tham chiếu const đến vector chứa cấu hình của các hành động.
     // @return Tham chiếu const đến vector cấu hình hành động.
     const std::vector<nlohmann::json>& getActionsConfig() const;
 
+    // Phương thức getActions: Các hành động đã tạo sẵn, theo thứ tự của cấu hình (rỗng nếu chưa buildActions).
+    const std::vector<ActionCommandRef>& getActions() const;
+
     // Phương thức getId: Trả về ID của quy tắc.
     // @return Tham chiếu const đến chuỗi ID của quy tắc.
     const std::string& getId() const;
+
+    // Cây điều kiện gốc và bytecode của nó (nullptr nếu không có), dùng để debug.
+    const ICondition* getCondition() const;
+    const ConditionProgram* getProgram() const;
+
+    const std::vector<std::string>& getEventTypes() const;
+    const std::vector<std::string>& getSourcePrefixes() const;
+
+    // Phương thức collectRequiredKeys: Key bắt buộc của cây điều kiện (xem ICondition::collectRequiredKeys).
+    // @return false nếu quy tắc có thể khớp với Event không có key nào trong keys.
+    bool collectRequiredKeys(std::vector<KeyId>& keys) const;
+
+    // Phương thức collectMandatoryKeys: Các key Event bắt buộc phải có để quy tắc có thể khớp
+    // (xem ICondition::collectMandatoryKeys). Kết quả đã sắp xếp, không trùng.
+    std::vector<KeyId> collectMandatoryKeys() const;
 };
@@ -0,0 +1,186 @@
+// rules/RuleIndex.cpp
+#include "RuleIndex.h"
+#include <algorithm> // For std::sort, std::unique, std::remove_if
+#include <limits>    // For std::numeric_limits
+
+namespace {
+
+// Chiều mà một quy tắc được đăng ký.
+enum class Anchor { None, MandatoryKey, AlternativeKeys, Type, Source };
+
+} // namespace
+
+// Constructor: Lượt đầu đếm số quy tắc dùng mỗi key/type/tiền tố nguồn, lượt sau chọn cho mỗi
+// quy tắc chiều có ít quy tắc dùng chung nhất và đăng ký quy tắc vào chiều đó.
+RuleIndex::RuleIndex(const std::vector<Rule>& rules) {
+    std::vector<std::vector<KeyId>> alternative_keys(rules.size());
+    std::vector<bool> has_alternatives(rules.size(), false);
+    std::unordered_map<KeyId, size_t> key_rules;
+    std::unordered_map<std::string_view, size_t> type_rules;
+    std::unordered_map<std::string_view, size_t> source_rules;
+
+    mandatory_keys_.reserve(rules.size());
+    for (size_t i = 0; i < rules.size(); ++i) {
+        const Rule& rule = rules[i];
+        mandatory_keys_.push_back(rule.collectMandatoryKeys());
+        std::vector<KeyId>& alternatives = alternative_keys[i];
+        has_alternatives[i] = rule.getCondition() != nullptr && rule.collectRequiredKeys(alternatives);
+        std::sort(alternatives.begin(), alternatives.end());
+        alternatives.erase(std::unique(alternatives.begin(), alternatives.end()), alternatives.end());
+
+        for (KeyId key : mandatory_keys_[i]) {
+            ++key_rules[key];
+        }
+        for (KeyId key : alternatives) {
+            if (!std::binary_search(mandatory_keys_[i].begin(), mandatory_keys_[i].end(), key)) {
+                ++key_rules[key];
+            }
+        }
+        for (const auto& type : rule.getEventTypes()) {
+            ++type_rules[type];
+        }
+        for (const auto& prefix : rule.getSourcePrefixes()) {
+            ++source_rules[prefix];
+        }
+    }
+
+    for (size_t i = 0; i < rules.size(); ++i) {
+        const Rule& rule = rules[i];
+        // Quy tắc không có điều kiện không bao giờ khớp: không đăng ký ở đâu cả.
+        if (!rule.getCondition()) {
+            continue;
+        }
+
+        Anchor anchor = Anchor::None;
+        size_t best_cost = std::numeric_limits<size_t>::max();
+        KeyId best_key = 0;
+        for (KeyId key : mandatory_keys_[i]) {
+            if (key_rules[key] < best_cost) {
+                best_cost = key_rules[key];
+                best_key = key;
+                anchor = Anchor::MandatoryKey;
+            }
+        }
+        if (anchor == Anchor::None && has_alternatives[i]) {
+            size_t cost = 0;
+            for (KeyId key : alternative_keys[i]) {
+                cost += key_rules[key];
+            }
+            best_cost = cost;
+            anchor = Anchor::AlternativeKeys;
+        }
+        if (!rule.getEventTypes().empty()) {
+            size_t cost = 0;
+            for (const auto& type : rule.getEventTypes()) {
+                cost += type_rules[type];
+            }
+            if (cost < best_cost) {
+                best_cost = cost;
+                anchor = Anchor::Type;
+            }
+        }
+        if (!rule.getSourcePrefixes().empty()) {
+            size_t cost = 0;
+            for (const auto& prefix : rule.getSourcePrefixes()) {
+                cost += source_rules[prefix];
+            }
+            if (cost < best_cost) {
+                best_cost = cost;
+                anchor = Anchor::Source;
+            }
+        }
+
+        auto addKey = [&](KeyId key) {
+            if (key >= by_key_.size()) {
+                by_key_.resize(static_cast<size_t>(key) + 1);
+            }
+            by_key_[key].push_back(i);
+        };
+        switch (anchor) {
+        case Anchor::MandatoryKey:
+            addKey(best_key);
+            ++stats_.by_key;
+            break;
+        case Anchor::AlternativeKeys:
+            for (KeyId key : alternative_keys[i]) {
+                addKey(key);
+            }
+            ++stats_.by_key;
+            break;
+        case Anchor::Type:
+            for (const auto& type : rule.getEventTypes()) {
+                std::vector<size_t>& posting = by_type_[type];
+                if (posting.empty() || posting.back() != i) { // Type có thể bị lặp trong cấu hình
+                    posting.push_back(i);
+                }
+            }
+            ++stats_.by_type;
+            break;
+        case Anchor::Source:
+            for (const auto& prefix : rule.getSourcePrefixes()) {
+                std::vector<size_t>& posting = by_source_prefix_[prefix];
+                if (posting.empty() || posting.back() != i) {
+                    posting.push_back(i);
+                }
+                source_prefix_lengths_.push_back(prefix.size());
+            }
+            ++stats_.by_source;
+            break;
+        case Anchor::None:
+            unindexed_.push_back(i);
+            ++stats_.unindexed;
+            break;
+        }
+    }
+    std::sort(source_prefix_lengths_.begin(), source_prefix_lengths_.end());
+    source_prefix_lengths_.erase(std::unique(source_prefix_lengths_.begin(), source_prefix_lengths_.end()),
+                                 source_prefix_lengths_.end());
+}
+
+// Phương thức candidates: Gom các danh sách quy tắc ứng với type, tiền tố nguồn và key của Event,
+// sắp xếp, loại trùng, rồi bỏ các quy tắc thiếu key bắt buộc.
+void RuleIndex::candidates(const Event& event, std::vector<size_t>& out) const {
+    const size_t first = out.size();
+    out.insert(out.end(), unindexed_.begin(), unindexed_.end());
+
+    if (!by_type_.empty()) {
+        auto it = by_type_.find(event.type);
+        if (it != by_type_.end()) {
+            out.insert(out.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    const std::string_view source(event.source);
+    for (size_t length : source_prefix_lengths_) {
+        if (length > source.size()) {
+            break;
+        }
+        auto it = by_source_prefix_.find(source.substr(0, length));
+        if (it != by_source_prefix_.end()) {
+            out.insert(out.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    for (const auto& entry : event.data) {
+        if (entry.first < by_key_.size()) {
+            const std::vector<size_t>& posting = by_key_[entry.first];
+            out.insert(out.end(), posting.begin(), posting.end());
+        }
+    }
+
+    std::sort(out.begin() + first, out.end());
+    auto unique_end = std::unique(out.begin() + first, out.end());
+    auto kept_end = std::remove_if(out.begin() + first, unique_end, [&](size_t rule_index) {
+        return !hasMandatoryKeys(rule_index, event);
+    });
+    out.erase(kept_end, out.end());
+}
+
+bool RuleIndex::hasMandatoryKeys(size_t rule_index, const Event& event) const {
+    for (KeyId key : mandatory_keys_[rule_index]) {
+        if (!event.data.contains(key)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,57 @@
+// rules/RuleIndex.h
+#pragma once
+
+#include "rules/Rule.h"
+#include "common/Event.h"
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// RuleIndex chọn ra các quy tắc ứng viên cho một Event, để RuleManager không phải đưa
+// mỗi Event qua toàn bộ quy tắc (với hàng nghìn quy tắc theo từng thiết bị, một Event chỉ
+// nên chạm tới vài chục quy tắc).
+//
+// Mỗi quy tắc được đăng ký dưới đúng một chiều, chiều chọn lọc nhất trong số:
+// - Key:    một key bắt buộc (key trong "and" đều bắt buộc), hoặc nếu không có key bắt buộc
+//           thì mọi key thay thế (mỗi nhánh của "or" góp một key, xem ICondition::collectRequiredKeys).
+// - Type:   các Event::type trong phạm vi "event_types" của quy tắc.
+// - Source: các tiền tố Event::source trong phạm vi "sources" của quy tắc.
+// Độ chọn lọc được ước lượng bằng số quy tắc cùng dùng giá trị đó (ít quy tắc dùng chung = chọn lọc hơn).
+// Quy tắc không có chiều nào (e.g., chỉ có "not") là ứng viên của mọi Event.
+//
+// Ứng viên còn được lọc theo key bắt buộc: quy tắc chỉ được trả về nếu Event có đủ mọi key bắt buộc.
+// Chỉ mục luôn "an toàn": quy tắc bị loại chắc chắn không khớp; ứng viên vẫn phải qua Rule::check.
+//
+// RuleIndex giữ chỉ số và string_view tới type/nguồn của quy tắc; caller phải dùng cùng vector<Rule>
+// đã tạo ra nó và giữ vector đó không đổi trong suốt vòng đời của RuleIndex.
+class RuleIndex {
+public:
+    // Số quy tắc đăng ký theo mỗi chiều.
+    struct Stats {
+        size_t by_key = 0;
+        size_t by_type = 0;
+        size_t by_source = 0;
+        size_t unindexed = 0;
+    };
+
+    // Constructor: Phân tích điều kiện và phạm vi của mọi quy tắc rồi tạo chỉ mục.
+    explicit RuleIndex(const std::vector<Rule>& rules);
+
+    // Phương thức candidates: Thêm vào out chỉ số các quy tắc có thể khớp với Event,
+    // theo thứ tự tăng dần (cùng thứ tự với rules), không trùng lặp.
+    void candidates(const Event& event, std::vector<size_t>& out) const;
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    bool hasMandatoryKeys(size_t rule_index, const Event& event) const;
+
+    std::vector<std::vector<KeyId>> mandatory_keys_;  // Key bắt buộc của mỗi quy tắc (đã sắp xếp)
+    std::vector<std::vector<size_t>> by_key_;         // Đánh chỉ số theo KeyId
+    std::unordered_map<std::string_view, std::vector<size_t>> by_type_;
+    std::unordered_map<std::string_view, std::vector<size_t>> by_source_prefix_;
+    std::vector<size_t> source_prefix_lengths_;       // Các độ dài tiền tố có trong by_source_prefix_
+    std::vector<size_t> unindexed_;                   // Ứng viên của mọi Event
+    Stats stats_;
+};
@@ -11,9 +11,7 @@ RuleManager& RuleManager::getInstance() {
 
 // Phương thức loadRules: Tải các quy tắc từ một file cấu hình JSON.
 void RuleManager::loadRules(const std::string& config_path) {
-    // Khóa mutex để đảm bảo an toàn luồng khi truy cập và sửa đổi danh sách quy tắc.
-    std::unique_lock<std::mutex> lock(rules_mutex_);
-
+    // Đọc, parse và biên dịch không giữ khóa nào: evaluate tiếp tục dùng RuleSet hiện hành.
     std::ifstream file(config_path);
     if (!file.is_open()) {
         throw std::runtime_error("Could not open rules configuration file: " + config_path);
@@ -45,35 +43,96 @@ void RuleManager::loadRules(const std::string& config_path) {
             std::cerr << "[RuleManager ERROR] Failed to parse a rule: " << e.what() << ". Skipping this rule." << std::endl;
         }
     }
+    size_t rule_count = new_rules.size();
+
+    // Chế độ đánh giá được đọc dưới reload_mutex_ để không lệch với một setEvaluationMode đồng thời.
+    std::unique_lock<std::mutex> lock(reload_mutex_);
+    bool alpha_network = evaluation_mode_.load() == EvaluationMode::AlphaNetwork;
+    publish(RuleSet::build(std::move(new_rules), alpha_network));
+    lock.unlock();
+    std::cout << "[RuleManager] Successfully loaded " << rule_count << " rules from " << config_path << std::endl;
+}
+
+// Phương thức publish: Đổi RuleSet hiện hành và thông báo IngestFilter mới (caller giữ reload_mutex_).
+void RuleManager::publish(std::shared_ptr<const RuleSet> ruleset) {
+    auto filter = ruleset->ingestFilter();
+    std::atomic_store(&ruleset_, std::move(ruleset));
+    for (const auto& listener : ingest_filter_listeners_) {
+        listener(filter);
+    }
+}
+
+// Phương thức setEvaluationMode: Chọn cách evaluate tìm các quy tắc khớp.
+// Nếu đã có quy tắc, công bố một RuleSet mới dùng chung quy tắc và chỉ mục với RuleSet hiện hành.
+void RuleManager::setEvaluationMode(EvaluationMode mode) {
+    std::unique_lock<std::mutex> lock(reload_mutex_);
+    evaluation_mode_.store(mode);
+    auto current = std::atomic_load(&ruleset_);
+    if (current) {
+        std::atomic_store(&ruleset_, current->withAlphaNetwork(mode == EvaluationMode::AlphaNetwork));
+    }
+}
+
+RuleManager::EvaluationMode RuleManager::getEvaluationMode() const {
+    return evaluation_mode_.load();
+}
+
+size_t RuleManager::getAlphaNodeCount() const {
+    auto ruleset = getRuleSet();
+    return ruleset && ruleset->alphaNetwork() ? ruleset->alphaNetwork()->alphaNodeCount() : 0;
+}
 
-    // Thay thế danh sách quy tắc cũ bằng danh sách mới đã được parse thành công.
-    // Sử dụng std::move để chuyển quyền sở hữu, hiệu quả hơn sao chép.
-    rules_ = std::move(new_rules);
-    std::cout << "[RuleManager] Successfully loaded " << rules_.size() << " rules from " << config_path << std::endl;
+RuleIndex::Stats RuleManager::getRuleIndexStats() const {
+    auto ruleset = getRuleSet();
+    return ruleset ? ruleset->index().stats() : RuleIndex::Stats{};
+}
+
+// Phương thức getRuleSet: Lấy RuleSet hiện hành mà không khóa.
+std::shared_ptr<const RuleSet> RuleManager::getRuleSet() const {
+    return std::atomic_load(&ruleset_);
+}
+
+// Phương thức getIngestFilter: Trả về IngestFilter của lần loadRules gần nhất.
+std::shared_ptr<const IngestFilter> RuleManager::getIngestFilter() const {
+    auto ruleset = getRuleSet();
+    return ruleset ? ruleset->ingestFilter() : nullptr;
+}
+
+// Phương thức subscribeIngestFilter: Đăng ký listener nhận IngestFilter mới sau mỗi lần loadRules.
+void RuleManager::subscribeIngestFilter(std::function<void(std::shared_ptr<const IngestFilter>)> listener) {
+    std::unique_lock<std::mutex> lock(reload_mutex_);
+    ingest_filter_listeners_.push_back(listener);
+    // Gọi dưới khóa: một loadRules đồng thời không thể giao filter mới hơn trước filter này.
+    if (auto filter = getIngestFilter()) {
+        listener(filter);
+    }
 }
 
 // Phương thức evaluate: Đánh giá một Event với tất cả các quy tắc đã tải.
-std::vector<nlohmann::json> RuleManager::evaluate(const Event& event) const {
-    std::vector<nlohmann::json> triggered_actions;
-    // Khóa mutex để đảm bảo an toàn luồng khi đọc danh sách quy tắc.
-    // Sử dụng unique_lock để cho phép các thao tác khác (như loadRules) có thể khóa mutex.
-    std::unique_lock<std::mutex> lock(rules_mutex_);
-
-    // Duyệt qua tất cả các quy tắc đã tải
-    for (const auto& rule : rules_) {
-        if (rule.check(event)) { // Kiểm tra xem quy tắc có khớp với Event không
-            std::cout << "[RuleManager] Rule '" << rule.getId() << "' matched for event ID: " << event.id << std::endl;
-            // Nếu quy tắc khớp, thêm tất cả các hành động của quy tắc này vào danh sách kích hoạt
-            for (const auto& action_cfg : rule.getActionsConfig()) {
-                triggered_actions.push_back(action_cfg);
-            }
-        }
+std::vector<ActionCommandRef> RuleManager::evaluate(const Event& event) const {
+    // Không khóa: chỉ lấy một bản sao shared_ptr của RuleSet hiện hành.
+    // loadRules đồng thời không ảnh hưởng tới RuleSet mà lần đánh giá này đang dùng.
+    auto ruleset = getRuleSet();
+    if (!ruleset) {
+        return {};
+    }
+    return ruleset->evaluate(event);
+}
+
+// Phương thức evaluateBatch: Đánh giá một lô Event trên cùng một RuleSet.
+std::vector<std::vector<ActionCommandRef>> RuleManager::evaluateBatch(const std::vector<Event>& events) const {
+    std::vector<std::vector<ActionCommandRef>> triggered_actions;
+    triggered_actions.reserve(events.size());
+
+    auto ruleset = getRuleSet();
+    for (const auto& event : events) {
+        triggered_actions.push_back(ruleset ? ruleset->evaluate(event) : std::vector<ActionCommandRef>{});
     }
     return triggered_actions;
 }
 
 // Phương thức getRulesCount: Trả về số lượng quy tắc hiện có.
 size_t RuleManager::getRulesCount() const {
-    std::unique_lock<std::mutex> lock(rules_mutex_); // Khóa để đọc số lượng quy tắc an toàn
-    return rules_.size();
+    auto ruleset = getRuleSet();
+    return ruleset ? ruleset->rules().size() : 0;
 }
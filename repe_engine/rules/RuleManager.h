@@ -3,20 +3,37 @@
 
 #include "rules/Rule.h"
 #include "rules/RuleParser.h"
+#include "rules/RuleSet.h" // Bộ quy tắc đã biên dịch, bất biến
 #include "common/Event.h"
+#include "common/IngestFilter.h" // Tóm tắt bộ quy tắc cho việc lọc tại EventProcessor
 #include <vector>
 #include <string>
 #include <memory>
-#include <mutex>     // For thread-safety if rules can be reloaded dynamically
+#include <functional> // For ingest filter listeners
+#include <mutex>     // Serializes reloads (evaluation never takes it)
+#include <atomic>    // For the published RuleSet and evaluation mode
 #include <fstream>   // For reading rule files
 #include <iostream>  // For logging
 
 // RuleManager là một Singleton, chịu trách nhiệm quản lý và tải các quy tắc.
 // Nó cung cấp một giao diện để RuleEngine đánh giá các Event dựa trên các quy tắc này.
+//
+// Bộ quy tắc hiện hành là một RuleSet bất biến, được công bố qua std::atomic_load/std::atomic_store
+// trên một shared_ptr (kiểu RCU). evaluate không khóa: nhiều luồng đánh giá song song, và loadRules
+// đọc file, parse và biên dịch bộ quy tắc mới ở bên ngoài rồi mới đổi vào, nên không làm đứng việc đánh giá.
 class RuleManager {
+public:
+    // Cách evaluate tìm các quy tắc khớp.
+    enum class EvaluationMode {
+        Linear,      // Kiểm tra lần lượt từng quy tắc (Rule::check)
+        AlphaNetwork // Tính mỗi phép thử khác nhau một lần cho mỗi Event (xem AlphaNetwork)
+    };
+
 private:
-    std::vector<Rule> rules_;         // Danh sách các quy tắc đã tải
-    mutable std::mutex rules_mutex_;  // Mutex để bảo vệ truy cập vào rules_ khi tải lại hoặc đánh giá
+    std::shared_ptr<const RuleSet> ruleset_; // Bộ quy tắc hiện hành (nullptr khi chưa tải), đọc/ghi bằng std::atomic_load/store
+    mutable std::mutex reload_mutex_;        // Tuần tự hóa các thao tác đổi ruleset_ và danh sách listener
+    std::vector<std::function<void(std::shared_ptr<const IngestFilter>)>> ingest_filter_listeners_;
+    std::atomic<EvaluationMode> evaluation_mode_{EvaluationMode::Linear};
 
     // Private constructor để đảm bảo chỉ có một thể hiện (Singleton Pattern)
     RuleManager() = default;
@@ -24,6 +41,11 @@ private:
     RuleManager(const RuleManager&) = delete;
     RuleManager& operator=(const RuleManager&) = delete;
 
+    // Công bố RuleSet mới và thông báo IngestFilter của nó cho các listener.
+    // Caller phải đang giữ reload_mutex_; listener cũng được gọi dưới khóa này để các IngestFilter
+    // đến listener đúng theo thứ tự đổi RuleSet (hai loadRules đồng thời không thể giao filter ngược thứ tự).
+    void publish(std::shared_ptr<const RuleSet> ruleset);
+
 public:
     // Phương thức tĩnh để lấy thể hiện duy nhất của RuleManager.
     // Đây là điểm truy cập toàn cục cho Singleton.
@@ -31,16 +53,52 @@ public:
 
     // Phương thức loadRules: Tải các quy tắc từ một file cấu hình JSON.
     // Nó sẽ thay thế danh sách quy tắc hiện có bằng các quy tắc mới từ file.
+    // Bộ quy tắc mới được tạo hoàn toàn trước khi đổi vào; evaluate đồng thời tiếp tục dùng bộ cũ.
     // @param config_path: Đường dẫn đến file cấu hình JSON chứa các quy tắc.
     // @throws std::runtime_error nếu không thể mở file hoặc parse JSON lỗi.
     void loadRules(const std::string& config_path);
 
     // Phương thức evaluate: Đánh giá một Event với tất cả các quy tắc đã tải.
+    // Chỉ các quy tắc ứng viên do RuleIndex chọn (theo key, type và nguồn của Event) mới được kiểm tra.
     // Trả về một vector chứa cấu hình của các hành động cần thực thi
     // từ các quy tắc đã khớp.
     // @param event: Event cần được đánh giá.
-    // @return Vector chứa các nlohmann::json object, mỗi object là cấu hình của một hành động.
-    std::vector<nlohmann::json> evaluate(const Event& event) const;
+    // @return Các hành động đã tạo sẵn (ActionCommandRef) của các quy tắc đã khớp.
+    std::vector<ActionCommandRef> evaluate(const Event& event) const;
+
+    // Phương thức evaluateBatch: Đánh giá một lô Event với tất cả các quy tắc đã tải.
+    // Cả lô dùng cùng một RuleSet (lấy một lần cho cả lô).
+    // @param events: Lô Event cần được đánh giá.
+    // @return Vector cùng kích thước với events; phần tử thứ i chứa các hành động
+    //         được kích hoạt bởi events[i] (rỗng nếu không có quy tắc nào khớp).
+    std::vector<std::vector<ActionCommandRef>> evaluateBatch(const std::vector<Event>& events) const;
+
+    // Phương thức getRuleSet: Bộ quy tắc hiện hành (không khóa).
+    // Caller có thể giữ RuleSet để đánh giá nhiều Event liên tiếp trên cùng một phiên bản quy tắc.
+    // @return RuleSet của lần loadRules gần nhất, hoặc nullptr nếu chưa tải quy tắc nào.
+    std::shared_ptr<const RuleSet> getRuleSet() const;
+
+    // Phương thức getIngestFilter: Tóm tắt các key, type và nguồn mà bộ quy tắc hiện tại có thể khớp.
+    // @return IngestFilter của lần loadRules gần nhất, hoặc nullptr nếu chưa tải quy tắc nào.
+    std::shared_ptr<const IngestFilter> getIngestFilter() const;
+
+    // Phương thức subscribeIngestFilter: Đăng ký nhận IngestFilter mới sau mỗi lần loadRules
+    // (e.g., EventProcessor::setIngestFilter). Nếu đã có quy tắc, listener được gọi ngay với filter hiện tại.
+    // Listener được gọi dưới reload_mutex_, theo đúng thứ tự công bố RuleSet: nó phải nhanh
+    // (ví dụ chỉ một atomic store) và không được gọi lại các phương thức tải/đăng ký của RuleManager.
+    void subscribeIngestFilter(std::function<void(std::shared_ptr<const IngestFilter>)> listener);
+
+    // Phương thức setEvaluationMode: Chọn cách evaluate tìm các quy tắc khớp.
+    // Với AlphaNetwork, mạng được biên dịch ngay cho các quy tắc hiện có và sau mỗi lần loadRules.
+    // Kết quả (quy tắc nào khớp, thứ tự hành động) giống hệt nhau ở cả hai chế độ.
+    void setEvaluationMode(EvaluationMode mode);
+    EvaluationMode getEvaluationMode() const;
+
+    // Phương thức getAlphaNodeCount: Số phép thử khác nhau trong mạng alpha (0 nếu không dùng mạng).
+    size_t getAlphaNodeCount() const;
+
+    // Phương thức getRuleIndexStats: Số quy tắc được đánh chỉ mục theo key, type, nguồn và không chỉ mục.
+    RuleIndex::Stats getRuleIndexStats() const;
 
     // Phương thức getRulesCount: Trả về số lượng quy tắc hiện có trong RuleManager.
     // @return Số lượng quy tắc.
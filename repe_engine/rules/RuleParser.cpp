@@ -2,6 +2,7 @@
 #include "RuleParser.h"
 #include "rules/conditions/ValueCondition.h"   // Bao gồm ValueCondition
 #include "rules/conditions/LogicalConditions.h" // Bao gồm AndCondition, OrCondition, NotCondition
+#include "common/EventValueJson.h"              // Chuyển giá trị JSON sang EventValue
 #include <iostream>    // For std::cerr
 #include <stdexcept>   // For std::runtime_error
 
@@ -39,8 +40,36 @@ std::unique_ptr<Rule> RuleParser::parse(const nlohmann::json& rule_json) {
         std::cerr << "[RuleParser WARNING] Rule '" + id + "' JSON missing 'actions' field or it's not an array. No actions will be configured." << std::endl;
     }
 
+    // Phạm vi tùy chọn của quy tắc: danh sách Event::type và tiền tố Event::source được chấp nhận
+    auto parseStringList = [&](const char* field) {
+        std::vector<std::string> values;
+        if (!rule_json.contains(field)) {
+            return values;
+        }
+        if (!rule_json[field].is_array()) {
+            throw std::runtime_error("Rule '" + id + "' field '" + field + "' must be an array of strings.");
+        }
+        for (const auto& value : rule_json[field]) {
+            if (!value.is_string()) {
+                throw std::runtime_error("Rule '" + id + "' field '" + field + "' must be an array of strings.");
+            }
+            values.push_back(value.get<std::string>());
+        }
+        return values;
+    };
+    std::vector<std::string> event_types = parseStringList("event_types");
+    std::vector<std::string> source_prefixes = parseStringList("sources");
+
     // Tạo và trả về đối tượng Rule mới
-    return std::make_unique<Rule>(id, std::move(condition), std::move(actions_config));
+    auto rule = std::make_unique<Rule>(id, std::move(condition), std::move(actions_config));
+    rule->setScope(std::move(event_types), std::move(source_prefixes));
+    // Biên dịch cây điều kiện sang bytecode; cây vẫn được giữ để debug.
+    if (!rule->compile()) {
+        std::cerr << "[RuleParser WARNING] Rule '" << id << "' condition could not be compiled. Evaluating the condition tree instead." << std::endl;
+    }
+    // Tạo sẵn các hành động; loại hành động chưa đăng ký khiến quy tắc bị từ chối ngay khi tải.
+    rule->buildActions();
+    return rule;
 }
 
 // Phương thức parseCondition: Đệ quy phân tích cú pháp một JSON object đại diện cho một điều kiện.
@@ -80,19 +109,12 @@ std::unique_ptr<ICondition> RuleParser::parseCondition(const nlohmann::json& con
         std::string op = cond_json["operator"].get<std::string>();
 
         // Chuyển đổi giá trị từ JSON sang EventValue (std::variant)
-        EventValue value;
-        if (cond_json["value"].is_number_integer()) {
-            value = cond_json["value"].get<int>();
-        } else if (cond_json["value"].is_number_float()) {
-            value = cond_json["value"].get<double>();
-        } else if (cond_json["value"].is_boolean()) {
-            value = cond_json["value"].get<bool>();
-        } else if (cond_json["value"].is_string()) {
-            value = cond_json["value"].get<std::string>();
-        } else {
+        // Số nguyên 64-bit và mảng số được giữ nguyên kiểu (xem EventValueJson.h)
+        std::optional<EventValue> value = eventValueFromJson(cond_json["value"]);
+        if (!value) {
             throw std::runtime_error("Unsupported value type in condition for key '" + key + "'.");
         }
-        return std::make_unique<ValueCondition>(key, op, value);
+        return std::make_unique<ValueCondition>(key, op, *value);
     } else {
         // Nếu không khớp với bất kỳ loại điều kiện nào đã biết
         throw std::runtime_error("Unknown condition type or missing required fields in condition JSON.");
@@ -17,7 +17,8 @@ public:
     // thành một đối tượng Rule.
     // @param rule_json: Đối tượng JSON chứa định nghĩa quy tắc.
     // @return unique_ptr tới đối tượng Rule đã được parse.
-    // @throws std::runtime_error nếu JSON không hợp lệ hoặc thiếu trường cần thiết.
+    // @throws std::runtime_error nếu JSON không hợp lệ, thiếu trường cần thiết,
+    //         hoặc một hành động không tạo được qua ActionFactory (xem Rule::buildActions).
     static std::unique_ptr<Rule> parse(const nlohmann::json& rule_json);
 
 private:
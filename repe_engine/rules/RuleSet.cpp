@@ -0,0 +1,82 @@
+// rules/RuleSet.cpp
+#include "RuleSet.h"
+#include <iostream> // For logging
+
+// Phương thức build: Biên dịch chỉ mục, IngestFilter và (tùy chọn) AlphaNetwork cho bộ quy tắc.
+std::shared_ptr<const RuleSet> RuleSet::build(std::vector<Rule> rules, bool alpha_network) {
+    std::shared_ptr<RuleSet> ruleset(new RuleSet());
+    ruleset->rules_ = std::make_shared<const std::vector<Rule>>(std::move(rules));
+    ruleset->index_ = std::make_shared<const RuleIndex>(*ruleset->rules_);
+    ruleset->ingest_filter_ = buildIngestFilter(*ruleset->rules_);
+
+    const RuleIndex::Stats& index_stats = ruleset->index_->stats();
+    std::cout << "[RuleSet] Rule index: " << index_stats.by_key << " by key, " << index_stats.by_type
+              << " by type, " << index_stats.by_source << " by source, " << index_stats.unindexed << " unindexed." << std::endl;
+    return ruleset->withAlphaNetwork(alpha_network);
+}
+
+// Phương thức withAlphaNetwork: Dùng lại quy tắc, chỉ mục và IngestFilter; chỉ biên dịch lại AlphaNetwork.
+std::shared_ptr<const RuleSet> RuleSet::withAlphaNetwork(bool alpha_network) const {
+    std::shared_ptr<RuleSet> ruleset(new RuleSet(*this));
+    ruleset->alpha_network_.reset();
+    if (alpha_network) {
+        ruleset->alpha_network_ = std::make_shared<const AlphaNetwork>(*rules_);
+        std::cout << "[RuleSet] Alpha network: " << ruleset->alpha_network_->testCount() << " tests in "
+                  << rules_->size() << " rules share " << ruleset->alpha_network_->alphaNodeCount()
+                  << " alpha nodes." << std::endl;
+    }
+    return ruleset;
+}
+
+// Phương thức buildIngestFilter: Tóm tắt mỗi quy tắc thành một IngestFilter::Scope.
+std::shared_ptr<const IngestFilter> RuleSet::buildIngestFilter(const std::vector<Rule>& rules) {
+    std::vector<IngestFilter::Scope> scopes;
+    scopes.reserve(rules.size());
+    for (const auto& rule : rules) {
+        IngestFilter::Scope scope;
+        scope.event_types = rule.getEventTypes();
+        scope.source_prefixes = rule.getSourcePrefixes();
+        scope.any_key = !rule.collectRequiredKeys(scope.keys);
+        if (scope.any_key) {
+            scope.keys.clear();
+        }
+        scopes.push_back(std::move(scope));
+    }
+    return std::make_shared<const IngestFilter>(std::move(scopes));
+}
+
+// Phương thức evaluate: Đánh giá một Event trên bộ quy tắc bất biến này (không khóa).
+std::vector<ActionCommandRef> RuleSet::evaluate(const Event& event) const {
+    std::vector<ActionCommandRef> triggered_actions;
+    const std::vector<Rule>& rules = *rules_;
+
+    // Nếu quy tắc khớp, thêm tất cả các hành động của quy tắc này vào danh sách kích hoạt
+    auto trigger = [&](const Rule& rule) {
+        std::cout << "[RuleManager] Rule '" << rule.getId() << "' matched for event ID: " << formatEventId(event.id) << std::endl;
+        const std::vector<ActionCommandRef>& actions = rule.getActions();
+        triggered_actions.insert(triggered_actions.end(), actions.begin(), actions.end());
+    };
+
+    // Chỉ xét các quy tắc ứng viên (theo thứ tự tải) mà RuleIndex chọn cho Event này
+    thread_local std::vector<size_t> candidates;
+    candidates.clear();
+    index_->candidates(event, candidates);
+
+    // Mạng alpha: mỗi phép thử khác nhau chỉ được tính một lần cho Event này
+    if (alpha_network_) {
+        thread_local std::vector<size_t> matched;
+        matched.clear();
+        alpha_network_->match(rules, event, candidates, matched);
+        for (size_t index : matched) {
+            trigger(rules[index]);
+        }
+        return triggered_actions;
+    }
+
+    for (size_t index : candidates) {
+        if (rules[index].check(event)) { // Kiểm tra xem quy tắc có khớp với Event không
+            trigger(rules[index]);
+        }
+    }
+    return triggered_actions;
+}
@@ -0,0 +1,55 @@
+// rules/RuleSet.h
+#pragma once
+
+#include "rules/Rule.h"
+#include "rules/RuleIndex.h"    // Chọn quy tắc ứng viên cho mỗi Event
+#include "rules/AlphaNetwork.h" // Mạng alpha dùng chung phép thử giữa các quy tắc
+#include "common/Event.h"
+#include "common/IngestFilter.h"
+#include <memory>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// RuleSet là một bộ quy tắc đã biên dịch và bất biến: danh sách Rule cùng mọi cấu trúc suy ra
+// từ nó (RuleIndex, AlphaNetwork tùy chọn, IngestFilter).
+//
+// RuleManager công bố RuleSet hiện hành qua một std::shared_ptr<const RuleSet> được đổi nguyên tử
+// (kiểu RCU): luồng đánh giá chỉ lấy một bản sao của shared_ptr rồi đánh giá trên đó mà không khóa;
+// loadRules tạo RuleSet mới hoàn toàn ở bên ngoài rồi mới đổi vào. RuleSet cũ được giải phóng khi
+// luồng đánh giá cuối cùng còn giữ nó trả lại shared_ptr.
+//
+// Mọi phương thức đều const và an toàn khi gọi đồng thời từ nhiều luồng.
+class RuleSet {
+public:
+    // Phương thức build: Tạo RuleSet từ các quy tắc đã parse.
+    // @param rules: Danh sách quy tắc (được move vào RuleSet).
+    // @param alpha_network: true để biên dịch thêm AlphaNetwork cho bộ quy tắc.
+    static std::shared_ptr<const RuleSet> build(std::vector<Rule> rules, bool alpha_network);
+
+    // Phương thức withAlphaNetwork: RuleSet mới dùng chung quy tắc, chỉ mục và IngestFilter với RuleSet này,
+    // có (hoặc không có) AlphaNetwork.
+    std::shared_ptr<const RuleSet> withAlphaNetwork(bool alpha_network) const;
+
+    // Phương thức evaluate: Đánh giá một Event với các quy tắc trong RuleSet.
+    // @return Các hành động đã tạo sẵn của mọi quy tắc khớp, theo thứ tự tải quy tắc
+    //         (chỉ sao chép con trỏ, không sao chép cấu hình JSON).
+    std::vector<ActionCommandRef> evaluate(const Event& event) const;
+
+    const std::vector<Rule>& rules() const { return *rules_; }
+    const RuleIndex& index() const { return *index_; }
+    const AlphaNetwork* alphaNetwork() const { return alpha_network_.get(); }
+    const std::shared_ptr<const IngestFilter>& ingestFilter() const { return ingest_filter_; }
+
+private:
+    RuleSet() = default;
+
+    // Tạo IngestFilter từ một danh sách quy tắc.
+    static std::shared_ptr<const IngestFilter> buildIngestFilter(const std::vector<Rule>& rules);
+
+    // Các phần được chia sẻ giữa những RuleSet chỉ khác nhau ở AlphaNetwork (xem withAlphaNetwork).
+    // RuleIndex và AlphaNetwork tham chiếu tới *rules_, nên rules_ phải sống lâu hơn chúng.
+    std::shared_ptr<const std::vector<Rule>> rules_;
+    std::shared_ptr<const RuleIndex> index_;
+    std::shared_ptr<const AlphaNetwork> alpha_network_; // nullptr: kiểm tra tuần tự từng ứng viên
+    std::shared_ptr<const IngestFilter> ingest_filter_;
+};
@@ -0,0 +1,83 @@
+// rules/conditions/ConditionProgram.cpp
+#include "ConditionProgram.h"
+#include <sstream> // For disassemble()
+
+// Phương thức addConstant: Thêm một phép so sánh với hằng số và trả về chỉ số của nó.
+uint32_t ConditionProgram::addConstant(const ValueComparison& comparison) {
+    constants_.push_back(comparison);
+    return static_cast<uint32_t>(constants_.size() - 1);
+}
+
+// Phương thức run: Vòng lặp thông dịch. Chương trình luôn kết thúc bằng Return (xem RuleParser).
+bool ConditionProgram::run(const Event& event, const uint8_t* alpha_memory) const {
+    const Instruction* code = code_.data();
+    const EventValue* value = nullptr;
+    bool acc = false;
+    for (uint32_t pc = 0;;) {
+        const Instruction& instruction = code[pc++];
+        switch (instruction.op) {
+        case OpCode::LoadKey:
+            value = event.data.get(instruction.arg);
+            break;
+        case OpCode::CompareConst:
+            acc = value != nullptr && constants_[instruction.arg](*value);
+            break;
+        case OpCode::JumpIfFalse:
+            if (!acc) pc = instruction.arg;
+            break;
+        case OpCode::JumpIfTrue:
+            if (acc) pc = instruction.arg;
+            break;
+        case OpCode::Not:
+            acc = !acc;
+            break;
+        case OpCode::SetAcc:
+            acc = instruction.arg != 0;
+            break;
+        case OpCode::TestAlpha:
+            acc = alpha_memory[instruction.arg] != 0;
+            break;
+        case OpCode::Return:
+            return acc;
+        }
+    }
+}
+
+// Phương thức disassemble: Dạng văn bản của chương trình để debug.
+std::string ConditionProgram::disassemble() const {
+    std::ostringstream out;
+    for (size_t pc = 0; pc < code_.size(); ++pc) {
+        const Instruction& instruction = code_[pc];
+        out << pc << ": ";
+        switch (instruction.op) {
+        case OpCode::LoadKey:
+            out << "LoadKey " << KeyRegistry::name(instruction.arg);
+            break;
+        case OpCode::CompareConst: {
+            const ValueComparison& comparison = constants_[instruction.arg];
+            out << "CompareConst " << compareOpToString(comparison.op()) << " " << eventValueToString(comparison.value());
+            break;
+        }
+        case OpCode::JumpIfFalse:
+            out << "JumpIfFalse " << instruction.arg;
+            break;
+        case OpCode::JumpIfTrue:
+            out << "JumpIfTrue " << instruction.arg;
+            break;
+        case OpCode::Not:
+            out << "Not";
+            break;
+        case OpCode::SetAcc:
+            out << "SetAcc " << (instruction.arg != 0 ? "true" : "false");
+            break;
+        case OpCode::TestAlpha:
+            out << "TestAlpha #" << instruction.arg;
+            break;
+        case OpCode::Return:
+            out << "Return";
+            break;
+        }
+        out << "\n";
+    }
+    return out.str();
+}
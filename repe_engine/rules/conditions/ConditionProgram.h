@@ -0,0 +1,76 @@
+// rules/conditions/ConditionProgram.h
+#pragma once
+
+#include "common/Event.h"
+#include "rules/conditions/ValueComparison.h" // Phép so sánh đã chuyên biệt hóa của CompareConst
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ConditionProgram là dạng biên dịch của một cây điều kiện (ICondition): một mảng lệnh liên tục
+// được chạy bởi một vòng lặp thông dịch, thay vì duyệt cây các node cấp phát rời rạc qua hàm ảo.
+//
+// Máy ảo chỉ có hai thanh ghi:
+// - value: con trỏ tới giá trị vừa nạp từ Event (nullptr nếu Event không có key).
+// - acc:   kết quả bool của điều kiện gần nhất; cũng là kết quả của chương trình khi gặp Return.
+//
+// Ví dụ {"and": [A, B]} được biên dịch thành:
+//     0: LoadKey      A.key
+//     1: CompareConst #0          ; acc = A
+//     2: JumpIfFalse  5           ; AND ngắn mạch
+//     3: LoadKey      B.key
+//     4: CompareConst #1          ; acc = B
+//     5: Return
+//
+// Cây điều kiện gốc vẫn được Rule giữ lại để debug (và làm dự phòng cho điều kiện không biên dịch được).
+class ConditionProgram {
+public:
+    enum class OpCode : uint8_t {
+        LoadKey,      // value = event.data.get(arg)
+        CompareConst, // acc = value != nullptr && constants[arg](*value)
+        JumpIfFalse,  // if (!acc) pc = arg
+        JumpIfTrue,   // if (acc) pc = arg
+        Not,          // acc = !acc
+        SetAcc,       // acc = (arg != 0), dùng cho AND/OR rỗng
+        TestAlpha,    // acc = alpha_memory[arg] (kết quả phép thử dùng chung, xem AlphaNetwork)
+        Return        // Kết thúc, trả về acc
+    };
+
+    // Một lệnh: 8 byte, các lệnh nằm liên tục trong bộ nhớ.
+    struct Instruction {
+        OpCode op;
+        uint32_t arg;
+    };
+
+    // Phương thức emit: Thêm một lệnh vào cuối chương trình.
+    // @return Vị trí của lệnh (dùng cho patchJump).
+    uint32_t emit(OpCode op, uint32_t arg = 0) {
+        code_.push_back(Instruction{op, arg});
+        return static_cast<uint32_t>(code_.size() - 1);
+    }
+
+    // Phương thức patchJump: Đặt đích của một lệnh nhảy đã emit.
+    void patchJump(uint32_t at, uint32_t target) { code_[at].arg = target; }
+
+    // Phương thức addConstant: Thêm một phép so sánh với hằng số.
+    // @return Chỉ số của hằng số (tham số của CompareConst).
+    uint32_t addConstant(const ValueComparison& comparison);
+
+    // Vị trí của lệnh tiếp theo sẽ được emit.
+    uint32_t nextPosition() const { return static_cast<uint32_t>(code_.size()); }
+
+    // Phương thức run: Chạy chương trình trên một Event.
+    // @param alpha_memory: Kết quả các phép thử đã tính sẵn cho Event, chỉ cần khi chương trình có TestAlpha.
+    // @return Kết quả của điều kiện (giống ICondition::evaluate của cây gốc).
+    bool run(const Event& event, const uint8_t* alpha_memory = nullptr) const;
+
+    // Phương thức disassemble: Dạng văn bản của chương trình, mỗi lệnh một dòng (để debug).
+    std::string disassemble() const;
+
+    const std::vector<Instruction>& code() const { return code_; }
+    const std::vector<ValueComparison>& constants() const { return constants_; }
+
+private:
+    std::vector<Instruction> code_;
+    std::vector<ValueComparison> constants_;
+};
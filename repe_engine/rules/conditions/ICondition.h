@@ -2,6 +2,9 @@
 #pragma once
 
 #include "common/Event.h" // Bao gồm cấu trúc Event
+#include <vector>
+
+class ConditionProgram; // Dạng bytecode của cây điều kiện (ConditionProgram.h)
 
 // ICondition là interface cho tất cả các điều kiện trong Rule Engine.
 // Đây là Abstract Expression trong Interpreter Pattern.
@@ -13,4 +16,27 @@ public:
     // Phương thức evaluate: Đánh giá điều kiện dựa trên một Event.
     // Trả về true nếu điều kiện được đáp ứng, ngược lại là false.
     virtual bool evaluate(const Event& event) const = 0;
+
+    // Phương thức collectRequiredKeys: Phân tích tĩnh dùng cho IngestFilter.
+    // Nếu điều kiện chỉ có thể đúng khi Event có ít nhất một trong các key nào đó,
+    // thêm các key này vào keys và trả về true. Mặc định trả về false (không suy ra được),
+    // nghĩa là điều kiện có thể đúng với bất kỳ Event nào.
+    virtual bool collectRequiredKeys(std::vector<KeyId>& keys) const {
+        (void)keys;
+        return false;
+    }
+
+    // Phương thức collectMandatoryKeys: Phân tích tĩnh dùng cho RuleIndex.
+    // Thêm vào keys các key mà Event bắt buộc phải có để điều kiện có thể đúng (tất cả, không phải một trong số).
+    // Mặc định không thêm gì (không có key bắt buộc). Key có thể bị lặp; caller tự sắp xếp và loại trùng.
+    virtual void collectMandatoryKeys(std::vector<KeyId>& keys) const {
+        (void)keys;
+    }
+
+    // Phương thức compile: Thêm các lệnh tính điều kiện này vào program (kết quả ở thanh ghi acc).
+    // Mặc định trả về false: điều kiện không biên dịch được và Rule sẽ đánh giá bằng cây.
+    virtual bool compile(ConditionProgram& program) const {
+        (void)program;
+        return false;
+    }
 };
@@ -1,5 +1,36 @@
 // rules/conditions/LogicalConditions.cpp
 #include "LogicalConditions.h" // Bao gồm file header của các điều kiện logic
+#include "ConditionProgram.h"  // Biên dịch cây điều kiện sang bytecode
+#include <algorithm>           // For std::sort, std::set_intersection
+#include <iterator>            // For std::back_inserter
+
+namespace {
+
+// Biên dịch chuỗi điều kiện con nối bằng lệnh nhảy ngắn mạch (dùng chung cho AND và OR).
+// Khi nhảy, acc đã mang kết quả cuối cùng nên đích nhảy là ngay sau chuỗi lệnh.
+// @param empty_result: Kết quả khi không có điều kiện con nào.
+bool compileShortCircuit(const std::vector<std::unique_ptr<ICondition>>& conditions, ConditionProgram& program,
+                         ConditionProgram::OpCode jump, bool empty_result) {
+    if (conditions.empty()) {
+        program.emit(ConditionProgram::OpCode::SetAcc, empty_result ? 1 : 0);
+        return true;
+    }
+    std::vector<uint32_t> jumps;
+    for (size_t i = 0; i < conditions.size(); ++i) {
+        if (!conditions[i]->compile(program)) {
+            return false;
+        }
+        if (i + 1 < conditions.size()) {
+            jumps.push_back(program.emit(jump));
+        }
+    }
+    for (uint32_t at : jumps) {
+        program.patchJump(at, program.nextPosition());
+    }
+    return true;
+}
+
+} // namespace
 
 // --- AndCondition ---
 // Thêm một điều kiện con vào danh sách.
@@ -22,6 +53,38 @@ bool AndCondition::evaluate(const Event& event) const {
     return true; // Nếu tất cả điều kiện con đều đúng, trả về true
 }
 
+// Phân tích tĩnh cho IngestFilter: AND chỉ đúng khi mọi điều kiện con đúng, nên key bắt buộc
+// của bất kỳ điều kiện con nào cũng là key bắt buộc của AND. Chọn tập nhỏ nhất để lọc chặt nhất.
+// @return false nếu không điều kiện con nào suy ra được key bắt buộc (kể cả AND rỗng, luôn đúng).
+bool AndCondition::collectRequiredKeys(std::vector<KeyId>& keys) const {
+    std::vector<KeyId> best;
+    bool found = false;
+    for (const auto& cond : conditions_) {
+        std::vector<KeyId> child_keys;
+        if (cond->collectRequiredKeys(child_keys) && (!found || child_keys.size() < best.size())) {
+            best = std::move(child_keys);
+            found = true;
+        }
+    }
+    if (found) {
+        keys.insert(keys.end(), best.begin(), best.end());
+    }
+    return found;
+}
+
+// Key bắt buộc của AND: hợp key bắt buộc của các điều kiện con.
+void AndCondition::collectMandatoryKeys(std::vector<KeyId>& keys) const {
+    for (const auto& cond : conditions_) {
+        cond->collectMandatoryKeys(keys);
+    }
+}
+
+// Biên dịch AND: sau mỗi điều kiện con (trừ điều kiện cuối), nhảy tới cuối nếu acc sai.
+// AND rỗng luôn đúng.
+bool AndCondition::compile(ConditionProgram& program) const {
+    return compileShortCircuit(conditions_, program, ConditionProgram::OpCode::JumpIfFalse, true);
+}
+
 // --- OrCondition ---
 // Thêm một điều kiện con vào danh sách.
 // @param cond: unique_ptr tới điều kiện con cần thêm.
@@ -43,6 +106,48 @@ bool OrCondition::evaluate(const Event& event) const {
     return false; // Nếu tất cả điều kiện con đều sai, trả về false
 }
 
+// Phân tích tĩnh cho IngestFilter: OR đúng khi một điều kiện con bất kỳ đúng, nên chỉ suy ra được
+// key bắt buộc khi mọi điều kiện con đều suy ra được; kết quả là hợp các key của chúng.
+// @return false nếu có điều kiện con không suy ra được, hoặc OR rỗng (luôn sai, nhưng giữ an toàn).
+bool OrCondition::collectRequiredKeys(std::vector<KeyId>& keys) const {
+    if (conditions_.empty()) {
+        return false;
+    }
+    std::vector<KeyId> all_keys;
+    for (const auto& cond : conditions_) {
+        if (!cond->collectRequiredKeys(all_keys)) {
+            return false;
+        }
+    }
+    keys.insert(keys.end(), all_keys.begin(), all_keys.end());
+    return true;
+}
+
+// Key bắt buộc của OR: giao key bắt buộc của các nhánh.
+void OrCondition::collectMandatoryKeys(std::vector<KeyId>& keys) const {
+    std::vector<KeyId> common;
+    for (size_t i = 0; i < conditions_.size(); ++i) {
+        std::vector<KeyId> branch;
+        conditions_[i]->collectMandatoryKeys(branch);
+        std::sort(branch.begin(), branch.end());
+        if (i == 0) {
+            common = std::move(branch);
+            continue;
+        }
+        std::vector<KeyId> intersection;
+        std::set_intersection(common.begin(), common.end(), branch.begin(), branch.end(),
+                              std::back_inserter(intersection));
+        common = std::move(intersection);
+    }
+    keys.insert(keys.end(), common.begin(), common.end());
+}
+
+// Biên dịch OR: sau mỗi điều kiện con (trừ điều kiện cuối), nhảy tới cuối nếu acc đúng.
+// OR rỗng luôn sai.
+bool OrCondition::compile(ConditionProgram& program) const {
+    return compileShortCircuit(conditions_, program, ConditionProgram::OpCode::JumpIfTrue, false);
+}
+
 // --- NotCondition ---
 // Constructor: Nhận một điều kiện con.
 // @param cond: unique_ptr tới điều kiện con.
@@ -62,3 +167,16 @@ bool NotCondition::evaluate(const Event& event) const {
     }
     return !condition_->evaluate(event); // Trả về kết quả ngược lại của điều kiện con
 }
+
+// Biên dịch NOT: điều kiện con rồi đảo acc. NOT không có điều kiện con luôn đúng (như evaluate).
+bool NotCondition::compile(ConditionProgram& program) const {
+    if (!condition_) {
+        program.emit(ConditionProgram::OpCode::SetAcc, 1);
+        return true;
+    }
+    if (!condition_->compile(program)) {
+        return false;
+    }
+    program.emit(ConditionProgram::OpCode::Not);
+    return true;
+}
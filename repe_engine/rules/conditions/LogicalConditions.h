@@ -21,6 +21,15 @@ public:
     // @param event: Event cần được đánh giá.
     // @return true nếu tất cả điều kiện con đều đúng, ngược lại false.
     bool evaluate(const Event& event) const override;
+
+    // Chỉ cần một điều kiện con suy ra được key bắt buộc; chọn điều kiện con có ít key nhất.
+    bool collectRequiredKeys(std::vector<KeyId>& keys) const override;
+
+    // Key bắt buộc của mọi điều kiện con đều bắt buộc (hợp).
+    void collectMandatoryKeys(std::vector<KeyId>& keys) const override;
+
+    // Biên dịch các điều kiện con, nối bằng JumpIfFalse tới cuối (ngắn mạch).
+    bool compile(ConditionProgram& program) const override;
 };
 
 // OrCondition: Điều kiện logic OR.
@@ -39,6 +48,15 @@ public:
     // @param event: Event cần được đánh giá.
     // @return true nếu ít nhất một điều kiện con đúng, ngược lại false.
     bool evaluate(const Event& event) const override;
+
+    // Mọi điều kiện con phải suy ra được key bắt buộc; kết quả là hợp của chúng.
+    bool collectRequiredKeys(std::vector<KeyId>& keys) const override;
+
+    // Chỉ key bắt buộc của mọi nhánh mới bắt buộc (giao).
+    void collectMandatoryKeys(std::vector<KeyId>& keys) const override;
+
+    // Biên dịch các điều kiện con, nối bằng JumpIfTrue tới cuối (ngắn mạch).
+    bool compile(ConditionProgram& program) const override;
 };
 
 // NotCondition: Điều kiện logic NOT.
@@ -57,4 +75,7 @@ public:
     // @param event: Event cần được đánh giá.
     // @return true nếu điều kiện con sai, ngược lại false.
     bool evaluate(const Event& event) const override;
+
+    // Biên dịch điều kiện con rồi thêm lệnh Not.
+    bool compile(ConditionProgram& program) const override;
 };
@@ -0,0 +1,168 @@
+// rules/conditions/ValueComparison.cpp
+#include "ValueComparison.h"
+#include <stdexcept>   // For std::invalid_argument
+#include <string>
+#include <type_traits> // For the compile-time type dispatch below
+
+// Parses a comparison operator once, when the rule is loaded.
+std::optional<CompareOp> parseCompareOp(std::string_view op) {
+    if (op == "==") return CompareOp::Eq;
+    if (op == "!=") return CompareOp::Ne;
+    if (op == ">") return CompareOp::Gt;
+    if (op == "<") return CompareOp::Lt;
+    if (op == ">=") return CompareOp::Ge;
+    if (op == "<=") return CompareOp::Le;
+    return std::nullopt;
+}
+
+const char* compareOpToString(CompareOp op) {
+    switch (op) {
+    case CompareOp::Eq: return "==";
+    case CompareOp::Ne: return "!=";
+    case CompareOp::Gt: return ">";
+    case CompareOp::Lt: return "<";
+    case CompareOp::Ge: return ">=";
+    case CompareOp::Le: return "<=";
+    }
+    return "?";
+}
+
+namespace {
+
+// Numeric alternatives of EventValue (bool is deliberately excluded).
+template <typename T>
+constexpr bool kIsNumeric = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+// Types that only support == and != (bool, blobs, numeric arrays).
+template <typename T>
+constexpr bool kEqualityOnly = !kIsNumeric<T> && !std::is_same_v<T, std::string>;
+
+// Three-way comparison of two integers of possibly different signedness
+// without the wrap-around of the usual arithmetic conversions.
+template <typename A, typename B>
+int compareIntegers(A a, B b) {
+    if constexpr (std::is_signed_v<A> == std::is_signed_v<B>) {
+        return a < b ? -1 : (b < a ? 1 : 0);
+    } else if constexpr (std::is_signed_v<A>) {
+        if (a < 0) return -1;
+        return compareIntegers(static_cast<uint64_t>(a), b);
+    } else {
+        if (b < 0) return 1;
+        return compareIntegers(a, static_cast<uint64_t>(b));
+    }
+}
+
+// Maps a three-way comparison result to the operator; resolved at compile time.
+template <CompareOp Op>
+bool fromOrdering(int ordering) {
+    if constexpr (Op == CompareOp::Eq) return ordering == 0;
+    else if constexpr (Op == CompareOp::Ne) return ordering != 0;
+    else if constexpr (Op == CompareOp::Gt) return ordering > 0;
+    else if constexpr (Op == CompareOp::Lt) return ordering < 0;
+    else if constexpr (Op == CompareOp::Ge) return ordering >= 0;
+    else return ordering <= 0;
+}
+
+// Floating-point comparison; an unordered result (NaN) only satisfies "!=".
+template <CompareOp Op>
+bool compareDoubles(double a, double b) {
+    if constexpr (Op == CompareOp::Eq) return a == b;
+    else if constexpr (Op == CompareOp::Ne) return !(a == b);
+    else if constexpr (Op == CompareOp::Gt) return a > b;
+    else if constexpr (Op == CompareOp::Lt) return a < b;
+    else if constexpr (Op == CompareOp::Ge) return a >= b;
+    else return a <= b;
+}
+
+// The comparator for a given (operator, constant type). Each instantiation only handles the
+// event value types that can match the constant; everything else is a type mismatch (false).
+template <CompareOp Op, typename R>
+bool compareTyped(const EventValue& event_value, const ComparisonConstant& constant) {
+    if constexpr (std::is_same_v<R, double>) {
+        // Any number against a floating-point constant compares as double.
+        switch (event_value.index()) {
+        case 0: return compareDoubles<Op>(static_cast<double>(*std::get_if<int>(&event_value)), constant.as_double);
+        case 1: return compareDoubles<Op>(*std::get_if<double>(&event_value), constant.as_double);
+        case 4: return compareDoubles<Op>(static_cast<double>(*std::get_if<int64_t>(&event_value)), constant.as_double);
+        case 5: return compareDoubles<Op>(static_cast<double>(*std::get_if<uint64_t>(&event_value)), constant.as_double);
+        default: return false;
+        }
+    } else if constexpr (kIsNumeric<R>) {
+        // Integer constant: exact integer comparison, or double if the event value is a double.
+        using K = std::conditional_t<std::is_signed_v<R>, int64_t, uint64_t>;
+        const K c = std::is_signed_v<R> ? static_cast<K>(constant.as_signed) : static_cast<K>(constant.as_unsigned);
+        switch (event_value.index()) {
+        case 0: return fromOrdering<Op>(compareIntegers(static_cast<int64_t>(*std::get_if<int>(&event_value)), c));
+        case 1: return compareDoubles<Op>(*std::get_if<double>(&event_value), constant.as_double);
+        case 4: return fromOrdering<Op>(compareIntegers(*std::get_if<int64_t>(&event_value), c));
+        case 5: return fromOrdering<Op>(compareIntegers(*std::get_if<uint64_t>(&event_value), c));
+        default: return false;
+        }
+    } else if constexpr (std::is_same_v<R, std::string>) {
+        const std::string* s = std::get_if<std::string>(&event_value);
+        if (s == nullptr) return false;
+        const std::string& c = *std::get_if<std::string>(&constant.value);
+        if constexpr (Op == CompareOp::Eq) return *s == c;
+        else if constexpr (Op == CompareOp::Ne) return *s != c;
+        else return fromOrdering<Op>(s->compare(c));
+    } else {
+        static_assert(Op == CompareOp::Eq || Op == CompareOp::Ne, "Only equality for this type");
+        const R* v = std::get_if<R>(&event_value);
+        if (v == nullptr) return false;
+        if constexpr (Op == CompareOp::Eq) return *v == *std::get_if<R>(&constant.value);
+        else return *v != *std::get_if<R>(&constant.value);
+    }
+}
+
+// Picks the instantiation of compareTyped for the runtime operator.
+template <typename R>
+ValueComparator selectComparator(CompareOp op) {
+    switch (op) {
+    case CompareOp::Eq: return &compareTyped<CompareOp::Eq, R>;
+    case CompareOp::Ne: return &compareTyped<CompareOp::Ne, R>;
+    default: break;
+    }
+    if constexpr (kEqualityOnly<R>) {
+        return nullptr; // Ordering is not defined for bool, blobs and arrays.
+    } else {
+        switch (op) {
+        case CompareOp::Gt: return &compareTyped<CompareOp::Gt, R>;
+        case CompareOp::Lt: return &compareTyped<CompareOp::Lt, R>;
+        case CompareOp::Ge: return &compareTyped<CompareOp::Ge, R>;
+        case CompareOp::Le: return &compareTyped<CompareOp::Le, R>;
+        default: return nullptr;
+        }
+    }
+}
+
+} // namespace
+
+// The positions used by the switch statements above must match the EventValue alternatives.
+static_assert(std::is_same_v<std::variant_alternative_t<0, EventValue>, int>);
+static_assert(std::is_same_v<std::variant_alternative_t<1, EventValue>, double>);
+static_assert(std::is_same_v<std::variant_alternative_t<4, EventValue>, int64_t>);
+static_assert(std::is_same_v<std::variant_alternative_t<5, EventValue>, uint64_t>);
+
+// Prepares the comparison: converts the constant once and selects the specialized comparator.
+// @throws std::invalid_argument if the operator is not defined for the constant's type.
+ValueComparison::ValueComparison(CompareOp op, EventValue value)
+    : op_(op), comparator_(nullptr) {
+    constant_.value = std::move(value);
+    comparator_ = std::visit([&](const auto& arg) -> ValueComparator {
+        using R = std::decay_t<decltype(arg)>;
+        if constexpr (kIsNumeric<R>) {
+            constant_.as_double = static_cast<double>(arg);
+            if constexpr (std::is_integral_v<R> && std::is_signed_v<R>) {
+                constant_.as_signed = static_cast<int64_t>(arg);
+            } else if constexpr (std::is_integral_v<R>) {
+                constant_.as_unsigned = static_cast<uint64_t>(arg);
+            }
+        }
+        return selectComparator<R>(op);
+    }, constant_.value);
+
+    if (comparator_ == nullptr) {
+        throw std::invalid_argument(std::string("Operator '") + compareOpToString(op) +
+                                    "' is not supported for this value type (only == and != are).");
+    }
+}
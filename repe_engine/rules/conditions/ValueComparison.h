@@ -0,0 +1,66 @@
+// rules/conditions/ValueComparison.h
+#pragma once
+
+#include "common/EventData.h" // EventValue
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// Toán tử so sánh của ValueCondition, được xác định một lần khi parse quy tắc.
+enum class CompareOp : uint8_t {
+    Eq, // ==
+    Ne, // !=
+    Gt, // >
+    Lt, // <
+    Ge, // >=
+    Le  // <=
+};
+
+// Chuyển chuỗi toán tử ("==", ">", ...) thành CompareOp; std::nullopt nếu không hợp lệ.
+std::optional<CompareOp> parseCompareOp(std::string_view op);
+
+// Dạng chuỗi của toán tử (để log và debug).
+const char* compareOpToString(CompareOp op);
+
+// Giá trị cố định của điều kiện, kèm các dạng đã chuyển đổi sẵn cho so sánh số khác kiểu
+// (e.g., giá trị trong Event là double còn hằng số là int), để đường nóng không phải chuyển đổi lại.
+struct ComparisonConstant {
+    EventValue value;
+    int64_t as_signed = 0;    // Khi value là số nguyên có dấu (int, int64_t)
+    uint64_t as_unsigned = 0; // Khi value là uint64_t
+    double as_double = 0.0;   // Khi value là số bất kỳ
+};
+
+// Hàm so sánh đã được chuyên biệt hóa (template) theo (toán tử, kiểu của hằng số).
+using ValueComparator = bool (*)(const EventValue& event_value, const ComparisonConstant& constant);
+
+// ValueComparison là một phép so sánh "giá trị trong Event <op> hằng số" đã được chuẩn bị sẵn:
+// toán tử là enum, hằng số đã được chuyển đổi, và hàm so sánh được chọn trước từ các bản
+// chuyên biệt hóa template, nên mỗi lần đánh giá chỉ còn một phép so sánh có kiểu.
+//
+// Quy tắc so sánh:
+// - Số (int, int64_t, uint64_t, double) so sánh theo giá trị giữa các kiểu; số nguyên với số nguyên
+//   là so sánh chính xác, có double thì so sánh trên double (NaN chỉ thỏa "!=").
+// - Chuỗi hỗ trợ mọi toán tử; bool, blob và mảng số chỉ hỗ trợ == và !=.
+// - Giá trị trong Event khác loại với hằng số (e.g., chuỗi với số) cho kết quả false.
+class ValueComparison {
+public:
+    // @throws std::invalid_argument nếu toán tử không được hỗ trợ cho kiểu của value.
+    ValueComparison(CompareOp op, EventValue value);
+
+    bool operator()(const EventValue& event_value) const { return comparator_(event_value, constant_); }
+
+    CompareOp op() const { return op_; }
+    const EventValue& value() const { return constant_.value; }
+
+    // Hai phép so sánh bằng nhau khi cùng toán tử và cùng hằng số (cùng kiểu và giá trị).
+    // Dùng để gộp các phép thử giống nhau giữa các quy tắc (xem AlphaNetwork).
+    bool operator==(const ValueComparison& other) const {
+        return op_ == other.op_ && constant_.value == other.constant_.value;
+    }
+
+private:
+    CompareOp op_;
+    ComparisonConstant constant_;
+    ValueComparator comparator_;
+};
@@ -2,6 +2,8 @@
 #pragma once
 
 #include "rules/conditions/ICondition.h" // Bao gồm interface điều kiện cơ sở
+#include "rules/conditions/ConditionProgram.h"
+#include "rules/conditions/ValueComparison.h" // Toán tử enum và hàm so sánh chuyên biệt hóa
 #include <string>     // For std::string
 #include <string_view> // C++17 for efficient string passing
 #include <variant>    // C++17 for EventValue (std::variant)
@@ -9,17 +11,20 @@
 // ValueCondition là một điều kiện cơ bản, so sánh một giá trị trong Event
 // với một giá trị cố định bằng một toán tử.
 // Đây là một Terminal Expression trong Interpreter Pattern.
+// Toán tử và kiểu của giá trị được xác định khi tạo điều kiện (xem ValueComparison),
+// nên evaluate() chỉ còn tra key và một phép so sánh có kiểu, không in lỗi trên đường nóng.
 class ValueCondition : public ICondition {
 private:
     std::string key_;       // Key của trường dữ liệu trong Event (e.g., "temperature")
-    std::string op_;        // Toán tử so sánh (e.g., ">", "<", "==", "!=", ">=", "<=")
-    EventValue value_;      // Giá trị để so sánh (được lưu trữ dưới dạng EventValue)
+    KeyId key_id_;          // Id đã intern của key_, được xác định một lần khi parse rule
+    ValueComparison comparison_; // Toán tử và giá trị để so sánh, đã chuẩn bị sẵn
 
 public:
     // Constructor của ValueCondition.
     // @param key: Tên key của trường dữ liệu trong Event.
-    // @param op: Toán tử so sánh.
+    // @param op: Toán tử so sánh ("==", "!=", ">", "<", ">=", "<=").
     // @param value: Giá trị để so sánh với dữ liệu trong Event.
+    // @throws std::invalid_argument nếu toán tử không hợp lệ hoặc không hỗ trợ kiểu của value.
     ValueCondition(std::string_view key, std::string_view op, const EventValue& value);
 
     // Phương thức evaluate: Thực hiện so sánh giá trị của trường dữ liệu trong Event
@@ -28,10 +33,13 @@ public:
     // @return true nếu điều kiện được đáp ứng, ngược lại false.
     bool evaluate(const Event& event) const override;
 
-private:
-    // Hàm trợ giúp để thực hiện so sánh giữa hai EventValue dựa trên toán tử.
-    // @param event_val: Giá trị từ Event.
-    // @param rule_val: Giá trị từ Rule (giá trị cố định của điều kiện).
-    // @return true nếu so sánh đúng, ngược lại false.
-    bool compare(const EventValue& event_val, const EventValue& rule_val) const;
+    // Điều kiện giá trị luôn sai khi Event không có key_, nên key_ là key bắt buộc.
+    bool collectRequiredKeys(std::vector<KeyId>& keys) const override;
+    void collectMandatoryKeys(std::vector<KeyId>& keys) const override;
+
+    bool compile(ConditionProgram& program) const override;
+
+    const std::string& getKey() const { return key_; }
+    KeyId getKeyId() const { return key_id_; }
+    const ValueComparison& getComparison() const { return comparison_; }
 };
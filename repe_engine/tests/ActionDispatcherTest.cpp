@@ -0,0 +1,185 @@
+// tests/ActionDispatcherTest.cpp
+#include "gtest/gtest.h"
+#include "action_dispatcher/ActionDispatcher.h"
+#include "actions/ActionFactory.h"
+#include "common/Event.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Đếm mọi lần cấp phát heap của chương trình test (thay thế operator new toàn cục)
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Hành động chậm ghi lại nguồn và ID của Event mà nó nhận được
+class RecordingAction : public IActionCommand {
+public:
+    void execute(const Event& event) const override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::lock_guard<std::mutex> lock(mutex_);
+        seen_.push_back(event.source + "#" + std::to_string(event.id));
+        events_.push_back(&event);
+    }
+
+    std::vector<std::string> seen() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return seen_;
+    }
+
+    std::vector<const Event*> events() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    mutable std::vector<std::string> seen_;
+    mutable std::vector<const Event*> events_;
+};
+
+// Test case: Hành động bất đồng bộ vẫn đọc được Event sau khi caller đã bỏ Event đi,
+// và mọi hành động của cùng một lần khớp dùng chung một ảnh chụp Event
+TEST(ActionDispatcherTest, ActionsShareEventSnapshot) {
+    auto first = std::make_shared<RecordingAction>();
+    auto second = std::make_shared<RecordingAction>();
+    {
+        ActionDispatcher dispatcher(2);
+        {
+            Event event;
+            event.id = 42;
+            event.source = "a_source_name_longer_than_small_buffer";
+            dispatcher.dispatch({first, second}, std::make_shared<const Event>(std::move(event)));
+        } // Bản Event của caller đã bị hủy trước khi các hành động chạy xong
+    } // Destructor chờ mọi hành động đã enqueue chạy xong
+
+    ASSERT_EQ(first->seen(), std::vector<std::string>{"a_source_name_longer_than_small_buffer#42"});
+    ASSERT_EQ(second->seen(), first->seen());
+    ASSERT_EQ(first->events(), second->events()); // Cùng một Event, không phải bản sao
+}
+
+// Hành động không làm gì ngoài đếm số lần chạy
+class CountingAction : public IActionCommand {
+public:
+    void execute(const Event&) const override { runs.fetch_add(1); }
+    mutable std::atomic<int> runs{0};
+};
+
+// Test case: Khi pool đã "ấm", dispatch không cấp phát heap nào (không packaged_task, future,
+// std::function hay node hàng đợi mới cho mỗi hành động)
+TEST(ActionDispatcherTest, DispatchIsAllocationFreeWhenWarm) {
+    ActionDispatcher dispatcher(2);
+    auto action = std::make_shared<CountingAction>();
+    const std::vector<ActionCommandRef> actions{action, action, action};
+    const EventRef event = std::make_shared<const Event>();
+
+    auto dispatchAndWait = [&](int calls) {
+        const int expected = action->runs.load() + calls * static_cast<int>(actions.size());
+        for (int i = 0; i < calls; ++i) {
+            dispatcher.dispatch(actions, event);
+        }
+        while (action->runs.load() < expected) {
+            std::this_thread::yield();
+        }
+    };
+
+    dispatchAndWait(1000); // Làm ấm: tạo đủ Task slot cho nhiều hơn số hành động đo bên dưới
+    const uint64_t before = g_allocations.load();
+    dispatchAndWait(100);
+    const uint64_t allocations = g_allocations.load() - before;
+    ASSERT_EQ(allocations, 0u);
+}
+
+// Trạng thái dùng chung của các BlockingAction trong một test
+struct BlockingState {
+    std::atomic<int> started{0};
+    std::atomic<bool> released{false};
+};
+
+// Hành động chặn luồng cho đến khi được giải phóng (mô phỏng lệnh shell bị treo)
+class BlockingAction : public IActionCommand {
+public:
+    explicit BlockingAction(BlockingState& state) : state_(state) {}
+
+    void execute(const Event&) const override {
+        state_.started.fetch_add(1);
+        while (!state_.released.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+private:
+    BlockingState& state_;
+};
+
+// Test case: Executor của một loại hành động bị treo đầy thì từ chối thêm hành động,
+// còn hành động loại khác vẫn chạy trên executor của nó
+TEST(ActionDispatcherTest, BulkheadIsolatesHangingActionType) {
+    ActionDispatcher::Options options;
+    options.default_executor = {"default", 1, 0, {}};
+    options.executors = {{"blocking", 1, 2, {"blocking"}}};
+    static BlockingState state; // Sống lâu hơn creator đã đăng ký trong ActionFactory
+    state.started.store(0); // Đặt lại trạng thái của lần chạy trước (--gtest_repeat)
+    state.released.store(false);
+    ActionFactory::registerAction("blocking", [](const nlohmann::json&) {
+        return std::make_unique<BlockingAction>(state);
+    });
+    ActionDispatcher dispatcher(options);
+
+    // Loại hành động là khóa đăng ký mà ActionFactory đã dùng, không do lớp hành động tự khai báo
+    ActionCommandRef blocking = ActionFactory::createAction({{"type", "blocking"}});
+    ASSERT_EQ(blocking->type(), "blocking");
+    auto counting = std::make_shared<CountingAction>(); // Không tạo qua ActionFactory: executor mặc định
+    const EventRef event = std::make_shared<const Event>();
+
+    dispatcher.dispatch({blocking}, event);
+    while (state.started.load() == 0) {
+        std::this_thread::yield();
+    }
+    // Luồng duy nhất đang bị treo: 2 hành động vào hàng đợi, 3 hành động bị từ chối
+    for (int i = 0; i < 5; ++i) {
+        dispatcher.dispatch({blocking}, event);
+    }
+    dispatcher.dispatch({counting}, event);
+    for (int i = 0; i < 5000 && counting->runs.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(counting->runs.load(), 1);
+
+    std::vector<ActionDispatcher::ExecutorStats> stats = dispatcher.executorStats();
+    ASSERT_EQ(stats.size(), 2u);
+    ASSERT_EQ(stats[1].name, "blocking");
+    ASSERT_EQ(stats[1].submitted, 3u);
+    ASSERT_EQ(stats[1].rejected, 3u);
+    ASSERT_EQ(stats[1].queue_depth, 2u);
+    ASSERT_EQ(stats[1].active, 1u);
+    ASSERT_DOUBLE_EQ(stats[1].saturation(), 1.0);
+    ASSERT_EQ(stats[0].submitted, 1u);
+    ASSERT_EQ(stats[0].rejected, 0u);
+
+    state.released.store(true); // Destructor chạy nốt các hành động đã nhận
+}
+
+// Test case: Một loại hành động chỉ được gán cho một executor
+TEST(ActionDispatcherTest, RejectsDuplicateActionType) {
+    ActionDispatcher::Options options;
+    options.executors = {{"a", 1, 0, {"log"}}, {"b", 1, 0, {"http", "log"}}};
+    ASSERT_THROW(ActionDispatcher dispatcher(options), std::invalid_argument);
+}
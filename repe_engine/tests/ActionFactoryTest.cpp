@@ -32,6 +32,8 @@ TEST_F(ActionFactoryTest, CreateLogAction) {
     ASSERT_NE(action, nullptr);
     // Kiểm tra xem đối tượng được tạo có đúng kiểu LogAction không.
     ASSERT_NE(dynamic_cast<LogAction*>(action.get()), nullptr);
+    // Loại hành động được ghi lại từ trường "type" của cấu hình (dùng để chọn executor).
+    ASSERT_EQ(action->type(), "log");
 }
 
 // Test case: Tạo HttpAction.
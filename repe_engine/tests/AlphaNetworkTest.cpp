@@ -0,0 +1,112 @@
+// tests/AlphaNetworkTest.cpp
+#include "gtest/gtest.h"
+#include "rules/AlphaNetwork.h"
+#include "rules/RuleManager.h"
+#include "rules/RuleParser.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <cstdio>
+
+// Định nghĩa trong actions/ActionFactory.cpp.
+extern void registerAllDefaultActions();
+
+// Parse một mảng quy tắc JSON thành vector<Rule>
+static std::vector<Rule> parseRules(const std::string& rules_json) {
+    registerAllDefaultActions();
+    std::vector<Rule> rules;
+    for (const auto& rule_json : nlohmann::json::parse(rules_json)) {
+        rules.push_back(std::move(*RuleParser::parse(rule_json)));
+    }
+    return rules;
+}
+
+static const char* kSharedRules = R"([
+    {"id": "hot_living", "condition": {"and": [
+        {"key": "location", "operator": "==", "value": "LivingRoom"},
+        {"key": "temperature", "operator": ">", "value": 30}]}, "actions": [{"type": "log", "message": "hot"}]},
+    {"id": "humid_living", "condition": {"and": [
+        {"key": "location", "operator": "==", "value": "LivingRoom"},
+        {"key": "humidity", "operator": ">=", "value": 80}]}, "actions": [{"type": "log", "message": "humid"}]},
+    {"id": "hot_or_humid", "condition": {"or": [
+        {"key": "temperature", "operator": ">", "value": 30},
+        {"not": {"key": "humidity", "operator": "<", "value": 80}}]}, "actions": [{"type": "log", "message": "any"}]},
+    {"id": "kitchen_only", "sources": ["sensor/kitchen"],
+     "condition": {"key": "temperature", "operator": ">", "value": 30}, "actions": [{"type": "log", "message": "k"}]}
+])";
+
+// Test case: Phép thử giống nhau giữa các quy tắc được gộp thành một alpha node
+TEST(AlphaNetworkTest, SharesIdenticalTests) {
+    std::vector<Rule> rules = parseRules(kSharedRules);
+    AlphaNetwork network(rules);
+
+    ASSERT_EQ(network.testCount(), 7u);
+    ASSERT_EQ(network.alphaNodeCount(), 4u); // location==, temperature>, humidity>=, humidity<
+
+    // Quy tắc chỉ còn đọc alpha memory, không nạp key của Event
+    const ConditionProgram* beta = network.getBetaProgram(0);
+    ASSERT_NE(beta, nullptr);
+    for (const auto& instruction : beta->code()) {
+        ASSERT_NE(instruction.op, ConditionProgram::OpCode::LoadKey);
+        ASSERT_NE(instruction.op, ConditionProgram::OpCode::CompareConst);
+    }
+}
+
+// Test case: Mạng alpha cho cùng kết quả với Rule::check trên nhiều Event khác nhau
+TEST(AlphaNetworkTest, MatchesSameRulesAsLinearCheck) {
+    std::vector<Rule> rules = parseRules(kSharedRules);
+    AlphaNetwork network(rules);
+
+    std::vector<Event> events(6);
+    events[0].data["location"] = std::string("LivingRoom");
+    events[0].data["temperature"] = 35;
+    events[1].data["location"] = std::string("LivingRoom");
+    events[1].data["humidity"] = 85.5;
+    events[2].data["location"] = std::string("Kitchen");
+    events[2].data["temperature"] = 20;
+    events[2].data["humidity"] = 10;
+    events[3].source = "sensor/kitchen/1";
+    events[3].data["temperature"] = 31.0;
+    events[4].data["unrelated"] = true; // Không có key nào: chỉ NOT có thể khớp
+    events[5].source = "socket/1";
+    events[5].data["temperature"] = std::string("35"); // Sai kiểu
+
+    for (const auto& event : events) {
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < rules.size(); ++i) {
+            if (rules[i].check(event)) {
+                expected.push_back(i);
+            }
+        }
+        std::vector<size_t> matched;
+        network.match(rules, event, matched);
+        ASSERT_EQ(matched, expected);
+    }
+}
+
+// Test case: RuleManager ở chế độ AlphaNetwork trả về cùng hành động như chế độ Linear
+TEST(AlphaNetworkTest, RuleManagerEvaluationModes) {
+    const std::string path = "alpha_network_test_rules.json";
+    {
+        std::ofstream file(path);
+        file << kSharedRules;
+    }
+    registerAllDefaultActions();
+    RuleManager& manager = RuleManager::getInstance();
+    manager.loadRules(path);
+    std::remove(path.c_str());
+
+    Event event;
+    event.data["location"] = std::string("LivingRoom");
+    event.data["temperature"] = 35;
+
+    ASSERT_EQ(manager.getAlphaNodeCount(), 0u);
+    std::vector<ActionCommandRef> linear = manager.evaluate(event);
+
+    manager.setEvaluationMode(RuleManager::EvaluationMode::AlphaNetwork);
+    ASSERT_EQ(manager.getAlphaNodeCount(), 4u);
+    std::vector<ActionCommandRef> shared = manager.evaluate(event);
+    manager.setEvaluationMode(RuleManager::EvaluationMode::Linear);
+
+    ASSERT_EQ(linear.size(), 2u); // hot_living, hot_or_humid
+    ASSERT_EQ(shared, linear); // Cùng các đối tượng hành động đã tạo sẵn
+}
@@ -0,0 +1,161 @@
+// tests/EventDataTest.cpp
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "common/Event.h"
+#include "rules/conditions/ValueCondition.h"
+#include <limits>
+#include "common/EventValueJson.h"
+
+// Test case: Cùng một tên key luôn được intern thành cùng một id
+TEST(KeyRegistryTest, InternIsStable) {
+    KeyId a = KeyRegistry::intern("key_registry_test_a");
+    KeyId b = KeyRegistry::intern("key_registry_test_b");
+    ASSERT_NE(a, b);
+    ASSERT_EQ(KeyRegistry::intern(std::string("key_registry_test_a")), a);
+    ASSERT_EQ(KeyRegistry::name(a), "key_registry_test_a");
+    ASSERT_EQ(KeyRegistry::lookup("key_registry_test_b"), b);
+}
+
+// Test case: Tra cứu theo tên không thêm key mới vào bảng intern
+TEST(KeyRegistryTest, LookupDoesNotIntern) {
+    Event event;
+    ASSERT_EQ(event.data.find("key_registry_never_seen"), event.data.end());
+    ASSERT_EQ(event.data.get("key_registry_never_seen"), nullptr);
+    ASSERT_FALSE(KeyRegistry::lookup("key_registry_never_seen").has_value());
+}
+
+// Test case: Dữ liệu được giữ sắp xếp theo KeyId và nằm inline với Event điển hình
+TEST(EventDataTest, SortedInlineStorage) {
+    EventData data;
+    data["temperature"] = 30.5;
+    data["location"] = std::string("LivingRoom");
+    data["humidity"] = 45;
+    data["temperature"] = 31.0; // Ghi đè, không thêm trường mới
+
+    ASSERT_EQ(data.size(), 3);
+    ASSERT_TRUE(data.isInline());
+    ASSERT_TRUE(std::is_sorted(data.begin(), data.end(),
+                               [](const auto& l, const auto& r) { return l.first < r.first; }));
+    ASSERT_EQ(std::get<double>(*data.get(KeyRegistry::intern("temperature"))), 31.0);
+    ASSERT_EQ(std::get<std::string>(data.find("location")->second), "LivingRoom");
+}
+
+// Test case: Vượt quá dung lượng inline thì chuyển sang heap mà không mất dữ liệu
+TEST(EventDataTest, SpillsToHeapBeyondInlineCapacity) {
+    EventData data;
+    const int fields = static_cast<int>(EventData::kInlineCapacity) + 4;
+    for (int i = 0; i < fields; ++i) {
+        data["spill_field_" + std::to_string(i)] = i;
+    }
+    ASSERT_FALSE(data.isInline());
+    ASSERT_EQ(data.size(), static_cast<size_t>(fields));
+    for (int i = 0; i < fields; ++i) {
+        ASSERT_EQ(std::get<int>(*data.get("spill_field_" + std::to_string(i))), i);
+    }
+
+    ASSERT_TRUE(data.erase(KeyRegistry::intern("spill_field_0")));
+    ASSERT_FALSE(data.contains("spill_field_0"));
+    ASSERT_EQ(data.size(), static_cast<size_t>(fields - 1));
+}
+
+// Test case: Sao chép và di chuyển giữ nguyên dữ liệu, đối tượng bị move trở nên rỗng
+TEST(EventDataTest, CopyAndMove) {
+    Event event;
+    event.data["status"] = std::string("OK");
+    event.data["fault_code"] = 7;
+
+    Event copy = event;
+    ASSERT_EQ(std::get<std::string>(*copy.data.get("status")), "OK");
+
+    Event moved = std::move(event);
+    ASSERT_EQ(std::get<int>(*moved.data.get("fault_code")), 7);
+    ASSERT_TRUE(event.data.empty());
+}
+
+// Test case: ValueCondition tra cứu theo id đã intern khi parse
+TEST(EventDataTest, ValueConditionUsesInternedKey) {
+    ValueCondition condition("interned_temperature", "==", 35);
+    Event event;
+    ASSERT_FALSE(condition.evaluate(event));
+    event.data["interned_temperature"] = 35;
+    ASSERT_TRUE(condition.evaluate(event));
+}
+
+// Test case: ID được cấp theo khối cho mỗi luồng, không trùng lặp giữa các luồng
+TEST(EventIdTest, UniqueAcrossThreads) {
+    constexpr int kThreads = 4;
+    constexpr int kIdsPerThread = 3000; // Nhiều hơn một khối ID
+    std::vector<std::vector<EventId>> ids(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kIdsPerThread; ++i) {
+                ids[t].push_back(generateUniqueId());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::vector<EventId> all;
+    for (const auto& v : ids) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+    ASSERT_NE(all.front(), 0u);
+    ASSERT_EQ(formatEventId(42), "evt_42");
+}
+
+// Test case: Số nguyên 64-bit, mảng số và binary từ JSON giữ nguyên kiểu, không bị cắt hay chuyển thành chuỗi
+TEST(EventValueJsonTest, KeepsWideIntegersArraysAndBlobs) {
+    ASSERT_TRUE(std::holds_alternative<int>(*eventValueFromJson(nlohmann::json(42))));
+    ASSERT_EQ(std::get<int64_t>(*eventValueFromJson(nlohmann::json(5000000000LL))), 5000000000LL);
+    ASSERT_EQ(std::get<uint64_t>(*eventValueFromJson(nlohmann::json(18000000000000000000ULL))), 18000000000000000000ULL);
+    ASSERT_EQ(std::get<EventIntArray>(*eventValueFromJson(nlohmann::json::array({1, 2, 3}))), (EventIntArray{1, 2, 3}));
+    ASSERT_EQ(std::get<EventDoubleArray>(*eventValueFromJson(nlohmann::json::array({1, 2.5}))), (EventDoubleArray{1.0, 2.5}));
+    ASSERT_EQ(std::get<EventBlob>(*eventValueFromJson(nlohmann::json::binary({1, 2, 3}))).bytes, (std::vector<uint8_t>{1, 2, 3}));
+    ASSERT_FALSE(eventValueFromJson(nlohmann::json::array({1, "a"})).has_value());
+    ASSERT_FALSE(eventValueFromJson(nlohmann::json::object()).has_value());
+
+    ASSERT_EQ(eventValueToJson(EventValue(EventIntArray{4, 5})), nlohmann::json::array({4, 5}));
+    ASSERT_EQ(eventValueToJson(EventValue(EventBlob{{'a', 'b', 'c', 'd'}})), "YWJjZA==");
+    ASSERT_EQ(eventValueToString(EventValue(EventDoubleArray{})), "[]");
+}
+
+// Test case: So sánh giữa các kiểu số khác nhau (int, int64_t, uint64_t, double) theo giá trị
+TEST(EventValueJsonTest, ValueConditionComparesMixedNumbers) {
+    Event event;
+    event.data["wide_counter"] = static_cast<int64_t>(5000000000LL);
+    event.data["unsigned_counter"] = static_cast<uint64_t>(18000000000000000000ULL);
+    event.data["samples"] = EventIntArray{1, 2, 3};
+
+    ASSERT_TRUE(ValueCondition("wide_counter", ">", 30).evaluate(event));
+    ASSERT_TRUE(ValueCondition("wide_counter", "<", 5000000000.5).evaluate(event));
+    ASSERT_TRUE(ValueCondition("unsigned_counter", ">", static_cast<int64_t>(-1)).evaluate(event));
+    ASSERT_TRUE(ValueCondition("samples", "==", EventIntArray{1, 2, 3}).evaluate(event));
+    ASSERT_TRUE(ValueCondition("samples", "!=", EventIntArray{1, 2}).evaluate(event));
+    // Toán tử không hỗ trợ cho kiểu của giá trị bị từ chối ngay khi tạo điều kiện
+    ASSERT_THROW(ValueCondition("samples", ">", EventIntArray{1, 2}), std::invalid_argument);
+}
+
+// Test case: Toán tử được xác định khi parse; so sánh int/double khác kiểu và NaN, khác loại cho false
+TEST(EventValueJsonTest, ValueConditionResolvesOperatorAtParse) {
+    ASSERT_THROW(ValueCondition("temperature", "=>", 1), std::invalid_argument);
+
+    Event event;
+    event.data["temperature"] = 30.5;
+    event.data["count"] = 7;
+    event.data["label"] = std::string("7");
+    event.data["nan"] = std::numeric_limits<double>::quiet_NaN();
+
+    ASSERT_TRUE(ValueCondition("temperature", ">", 30).evaluate(event));   // double với hằng số int
+    ASSERT_TRUE(ValueCondition("count", "<=", 7.0).evaluate(event));       // int với hằng số double
+    ASSERT_TRUE(ValueCondition("count", "==", static_cast<uint64_t>(7)).evaluate(event));
+    ASSERT_FALSE(ValueCondition("label", "==", 7).evaluate(event));        // Chuỗi với số: false
+    ASSERT_FALSE(ValueCondition("nan", "==", 1.0).evaluate(event));
+    ASSERT_TRUE(ValueCondition("nan", "!=", 1.0).evaluate(event));
+    ASSERT_TRUE(ValueCondition("label", ">=", std::string("5")).evaluate(event));
+}
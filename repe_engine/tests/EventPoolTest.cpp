@@ -0,0 +1,97 @@
+// tests/EventPoolTest.cpp
+#include "gtest/gtest.h"
+#include "core/EventPool.h"
+#include "core/EventProcessor.h"
+#include "core/EventQueue.h"
+
+// Test case: Event trả về pool được tái sử dụng ở dạng rỗng nhưng giữ dung lượng chuỗi
+TEST(EventPoolTest, ReusesReleasedEvents) {
+    EventPool pool;
+    Event event = pool.acquire();
+    event.source = "a_source_name_longer_than_small_buffer";
+    event.data["value"] = 1;
+    const size_t source_capacity = event.source.capacity();
+    pool.release(std::move(event));
+    ASSERT_EQ(pool.size(), 1);
+
+    Event reused = pool.acquire();
+    ASSERT_TRUE(reused.source.empty());
+    ASSERT_TRUE(reused.data.empty());
+    ASSERT_GE(reused.source.capacity(), source_capacity);
+
+    EventPool::Stats stats = pool.stats();
+    ASSERT_EQ(stats.acquired, 2);
+    ASSERT_EQ(stats.reused, 1);
+}
+
+// Test case: releaseBatch trả cả lô, pool không giữ quá max_pooled Event
+TEST(EventPoolTest, ReleaseBatchRespectsLimit) {
+    EventPool pool(2);
+    std::vector<Event> batch(3);
+    pool.releaseBatch(batch);
+    ASSERT_TRUE(batch.empty());
+    ASSERT_EQ(pool.size(), 2);
+    ASSERT_EQ(pool.stats().discarded, 1);
+}
+
+// Test case: EventProcessor lấy Event từ pool và điền đầy đủ các trường
+TEST(EventPoolTest, ProcessorAcquiresFromPool) {
+    EventQueue queue;
+    EventPool pool;
+    EventProcessor processor(queue, &pool);
+
+    ASSERT_TRUE(processor.processRawData("pool_source", "reading", 7, "value"));
+    std::vector<Event> batch;
+    ASSERT_EQ(queue.popBatch(batch, 8, std::chrono::milliseconds(0)), 1);
+    pool.releaseBatch(batch);
+
+    ASSERT_TRUE(processor.processRawData("pool_source", "reading", 8, "value"));
+    Event event = queue.pop();
+    ASSERT_EQ(pool.stats().reused, 1);
+    ASSERT_EQ(event.source, "pool_source");
+    ASSERT_EQ(event.type, "reading");
+    ASSERT_EQ(std::get<int>(*event.data.get("value")), 8);
+    ASSERT_NE(event.id, 0u);
+}
+
+// Test case: Event lấy từ pool nhưng không vào hàng đợi (JSON lỗi, bị từ chối) được trả lại pool
+TEST(EventPoolTest, ProcessorReturnsUnqueuedEventsToPool) {
+    EventQueue::Options options;
+    options.capacity = 1;
+    options.overflow_policy = EventQueue::OverflowPolicy::DropNewest;
+    EventQueue queue(options);
+    EventPool pool;
+    EventProcessor processor(queue, &pool);
+
+    ASSERT_FALSE(processor.processRawJsonData("pool_source", "{not json"));
+    ASSERT_TRUE(processor.processRawJsonData("pool_source", R"({"value": 1})"));
+    ASSERT_FALSE(processor.processRawJsonData("pool_source", R"({"value": 2})")); // Hàng đợi đầy
+    ASSERT_FALSE(processor.processRawData("pool_source", "reading", 3, "value"));  // Hàng đợi đầy
+    // NDJSON: một dòng lỗi và hai Event bị pushBatch từ chối
+    ASSERT_EQ(processor.processRawJsonBatch("pool_source", "{\"value\": 4}\n{not json\n{\"value\": 5}\n"), 0u);
+
+    // Chỉ Event đang nằm trong hàng đợi là chưa quay về pool
+    EventPool::Stats stats = pool.stats();
+    ASSERT_EQ(stats.acquired, 7u);
+    ASSERT_EQ(stats.released + stats.discarded, 6u);
+    ASSERT_EQ(queue.size(), 1u);
+}
+
+// Test case: Event chia sẻ qua share() quay về pool khi EventRef cuối cùng được giải phóng
+TEST(EventPoolTest, SharedEventReturnsToPoolAfterLastReference) {
+    EventPool pool;
+    Event event = pool.acquire();
+    event.source = "shared_source";
+    event.data["value"] = 1;
+
+    EventRef shared = pool.share(std::move(event));
+    EventRef other = shared; // Hành động thứ hai dùng chung, không sao chép Event
+    ASSERT_EQ(other->source, "shared_source");
+    ASSERT_EQ(pool.size(), 0);
+
+    shared.reset();
+    ASSERT_EQ(pool.size(), 0);
+    other.reset();
+    ASSERT_EQ(pool.size(), 1);
+    ASSERT_TRUE(pool.acquire().source.empty());
+}
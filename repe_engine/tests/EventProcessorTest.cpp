@@ -0,0 +1,184 @@
+// tests/EventProcessorTest.cpp
+#include "gtest/gtest.h"
+#include "core/EventProcessor.h"
+#include "core/EventQueue.h"
+
+// Tạo hàng đợi có giới hạn 1 Event, bỏ Event mới khi đầy
+static EventQueue::Options singleSlotOptions() {
+    EventQueue::Options options;
+    options.capacity = 1;
+    options.overflow_policy = EventQueue::OverflowPolicy::DropNewest;
+    return options;
+}
+
+// Test case: processRawData báo Event có được nhận vào hàng đợi hay không
+TEST(EventProcessorTest, ProcessRawDataReportsAdmission) {
+    EventQueue queue(singleSlotOptions());
+    EventProcessor processor(queue);
+
+    ASSERT_TRUE(processor.processRawData("unittest", "reading", 42, "value"));
+    ASSERT_FALSE(processor.processRawData("unittest", "reading", 43, "value")); // Hàng đợi đầy
+    ASSERT_EQ(queue.stats().dropped_newest, 1);
+}
+
+// Test case: processRawJsonData trả về false khi JSON lỗi hoặc Event bị từ chối
+TEST(EventProcessorTest, ProcessRawJsonDataReportsAdmission) {
+    EventQueue queue(singleSlotOptions());
+    EventProcessor processor(queue);
+
+    ASSERT_FALSE(processor.processRawJsonData("unittest", "{not json"));
+    ASSERT_TRUE(processor.processRawJsonData("unittest", R"({"type": "reading", "value": 1})"));
+    ASSERT_FALSE(processor.processRawJsonData("unittest", R"({"type": "reading", "value": 2})"));
+
+    queue.pop();
+    queue.close();
+    ASSERT_FALSE(processor.processRawJsonData("unittest", R"({"type": "reading", "value": 3})"));
+}
+
+// Test case: processRawJsonData giữ mảng mẫu đo dưới dạng mảng số, không dump thành chuỗi
+TEST(EventProcessorTest, ProcessRawJsonKeepsNativeArrays) {
+    EventQueue queue;
+    EventProcessor processor(queue);
+
+    ASSERT_TRUE(processor.processRawJsonData("unittest", R"({"type": "samples", "raw": [1, 2, 3], "scaled": [0.5, 1.5], "ticks": 9000000000})"));
+    Event event = queue.pop();
+    ASSERT_EQ(event.type, "samples");
+    ASSERT_EQ(std::get<EventIntArray>(*event.data.get("raw")), (EventIntArray{1, 2, 3}));
+    ASSERT_EQ(std::get<EventDoubleArray>(*event.data.get("scaled")), (EventDoubleArray{0.5, 1.5}));
+    ASSERT_EQ(std::get<int64_t>(*event.data.get("ticks")), 9000000000LL);
+}
+
+// Test case: Đường SAX xử lý type mặc định, trường meta, null, object lồng nhau và mảng không thuần nhất
+TEST(EventProcessorTest, ProcessRawJsonSaxMapping) {
+    EventQueue queue;
+    EventProcessor processor(queue);
+
+    ASSERT_TRUE(processor.processRawJsonData("unittest",
+        R"({"_source_id": "x", "flag": true, "note": null, "nested": {"a": [1, {"b": 2}]}, "mixed": [1, "two", 3.5], "big": [1, 18446744073709551615]})"));
+    Event event = queue.pop();
+    ASSERT_EQ(event.type, "generic_json_event");
+    ASSERT_FALSE(event.data.contains("_source_id"));
+    ASSERT_EQ(std::get<bool>(*event.data.get("flag")), true);
+    ASSERT_EQ(std::get<std::string>(*event.data.get("note")), "null");
+    ASSERT_EQ(nlohmann::json::parse(std::get<std::string>(*event.data.get("nested"))), nlohmann::json::parse(R"({"a": [1, {"b": 2}]})"));
+    ASSERT_EQ(nlohmann::json::parse(std::get<std::string>(*event.data.get("mixed"))), nlohmann::json::parse(R"([1, "two", 3.5])"));
+    ASSERT_EQ(std::get<EventDoubleArray>(*event.data.get("big")).size(), 2u);
+}
+
+// Test case: Khi bảng key chạm giới hạn intern-on-ingest, key mới của payload bị bỏ qua,
+// còn key đã biết (ví dụ key mà quy tắc tham chiếu) vẫn được giữ
+TEST(EventProcessorTest, IngestKeyInterningIsCapped) {
+    EventQueue queue;
+    EventProcessor processor(queue);
+    const KeyId known = KeyRegistry::intern("capped_known_key");
+    const size_t previous_limit = KeyRegistry::maxIngestKeys();
+    const uint64_t previous_rejected = KeyRegistry::rejectedIngestKeys();
+    KeyRegistry::setMaxIngestKeys(KeyRegistry::size());
+
+    const bool admitted = processor.processRawJsonData("unittest",
+        R"({"capped_known_key": 1, "capped_unknown_key_1": 2, "capped_unknown_key_2": {"x": 3}})");
+    KeyRegistry::setMaxIngestKeys(previous_limit);
+
+    ASSERT_TRUE(admitted);
+    Event event = queue.pop();
+    ASSERT_EQ(std::get<int>(*event.data.get(known)), 1);
+    ASSERT_EQ(event.data.size(), 1u);
+    ASSERT_FALSE(KeyRegistry::lookup("capped_unknown_key_1").has_value());
+    ASSERT_EQ(KeyRegistry::rejectedIngestKeys() - previous_rejected, 2u);
+}
+
+// Test case: JSON lỗi, JSON không phải object và type không phải chuỗi đều bị từ chối
+TEST(EventProcessorTest, ProcessRawJsonRejectsInvalidInput) {
+    EventQueue queue;
+    EventProcessor processor(queue);
+
+    ASSERT_FALSE(processor.processRawJsonData("unittest", R"({"type": "broken", )"));
+    ASSERT_FALSE(processor.processRawJsonData("unittest", R"([1, 2, 3])"));
+    ASSERT_FALSE(processor.processRawJsonData("unittest", R"(42)"));
+    ASSERT_FALSE(processor.processRawJsonData("unittest", R"({"type": 5})"));
+    ASSERT_TRUE(queue.isEmpty());
+}
+
+// Test case: processRawJsonBatch tách NDJSON theo dòng, bỏ dòng trống/lỗi và đẩy cả lô vào hàng đợi
+TEST(EventProcessorTest, ProcessRawJsonBatchSplitsLines) {
+    EventQueue queue;
+    EventProcessor processor(queue);
+
+    std::string buffer =
+        "{\"type\": \"reading\", \"value\": 1}\r\n"
+        "\n"
+        "{not json\n"
+        "{\"type\": \"reading\", \"value\": 2}\n"
+        "{\"value\": 3}";
+    ASSERT_EQ(processor.processRawJsonBatch("unittest", buffer), 3u);
+    ASSERT_EQ(queue.stats().admitted, 3);
+
+    for (int expected = 1; expected <= 3; ++expected) {
+        Event event = queue.pop();
+        ASSERT_EQ(event.source, "unittest");
+        ASSERT_EQ(std::get<int>(*event.data.get("value")), expected);
+    }
+    ASSERT_EQ(processor.processRawJsonBatch("unittest", "\n\n"), 0u);
+}
+
+// Test case: processRawJsonBatch chỉ trả về số Event thực sự được nhận vào hàng đợi
+TEST(EventProcessorTest, ProcessRawJsonBatchReportsAdmission) {
+    EventQueue queue(singleSlotOptions());
+    EventProcessor processor(queue);
+
+    ASSERT_EQ(processor.processRawJsonBatch("unittest", "{\"value\": 1}\n{\"value\": 2}\n"), 1u);
+    ASSERT_EQ(queue.stats().dropped_newest, 1);
+}
+
+// Struct telemetry đăng ký mô tả trường (ánh xạ trực tiếp)
+struct DirectTelemetry {
+    float temperature;
+    int humidity;
+    uint64_t counter;
+    bool online;
+    std::string location;
+    EventIntArray samples;
+};
+REPE_EVENT_FIELDS(DirectTelemetry,
+    REPE_EVENT_FIELD(DirectTelemetry, temperature),
+    REPE_EVENT_FIELD(DirectTelemetry, humidity),
+    REPE_EVENT_FIELD(DirectTelemetry, counter),
+    REPE_EVENT_FIELD(DirectTelemetry, online),
+    REPE_EVENT_FIELD(DirectTelemetry, location),
+    REPE_EVENT_FIELD(DirectTelemetry, samples));
+
+// Struct tương tự nhưng chỉ có to_json (đường JSON dự phòng)
+struct JsonTelemetry {
+    float temperature;
+    int humidity;
+    uint64_t counter;
+    bool online;
+    std::string location;
+    EventIntArray samples;
+};
+static void to_json(nlohmann::json& j, const JsonTelemetry& t) {
+    j = nlohmann::json{{"temperature", t.temperature}, {"humidity", t.humidity}, {"counter", t.counter},
+                       {"online", t.online}, {"location", t.location}, {"samples", t.samples}};
+}
+
+// Test case: Struct đăng ký REPE_EVENT_FIELDS cho cùng dữ liệu với đường to_json
+TEST(EventProcessorTest, ProcessStructuredDataDirectMatchesJsonPath) {
+    EventQueue queue;
+    EventProcessor processor(queue);
+
+    ASSERT_TRUE(processor.processStructuredData("unittest", "telemetry", DirectTelemetry{21.5f, 40, 7, true, "Lab", {1, 2}}));
+    ASSERT_TRUE(processor.processStructuredData("unittest", "telemetry", JsonTelemetry{21.5f, 40, 7, true, "Lab", {1, 2}}));
+    Event direct = queue.pop();
+    Event via_json = queue.pop();
+
+    ASSERT_EQ(direct.type, "telemetry");
+    ASSERT_EQ(direct.data.size(), 6u);
+    ASSERT_EQ(direct.data.size(), via_json.data.size());
+    for (const auto& [key, value] : via_json.data) {
+        const EventValue* direct_value = direct.data.get(key);
+        ASSERT_NE(direct_value, nullptr) << KeyRegistry::name(key);
+        ASSERT_EQ(*direct_value, value) << KeyRegistry::name(key);
+    }
+    ASSERT_EQ(std::get<int>(*direct.data.get("humidity")), 40);
+    ASSERT_DOUBLE_EQ(std::get<double>(*direct.data.get("temperature")), 21.5);
+}
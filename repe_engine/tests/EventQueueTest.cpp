@@ -14,7 +14,7 @@ protected:
 // Test case: Push và Pop một sự kiện đơn lẻ
 TEST_F(EventQueueTest, PushAndPopSingleEvent) {
     Event test_event;
-    test_event.id = "test_1";
+    test_event.id = 1;
     test_event.type = "simple_test";
     test_event.source = "unittest";
     test_event.data["value"] = 123;
@@ -27,7 +27,7 @@ TEST_F(EventQueueTest, PushAndPopSingleEvent) {
     ASSERT_TRUE(queue.isEmpty());
     ASSERT_EQ(queue.size(), 0);
 
-    ASSERT_EQ(popped_event.id, "test_1");
+    ASSERT_EQ(popped_event.id, 1u);
     ASSERT_EQ(popped_event.type, "simple_test");
     ASSERT_EQ(popped_event.source, "unittest");
     ASSERT_TRUE(std::holds_alternative<int>(popped_event.data["value"]));
@@ -57,7 +57,7 @@ TEST_F(EventQueueTest, MultiThreadedProducerConsumer) {
         producer_threads.emplace_back([&, i]() {
             for (int j = 0; j < events_per_producer; ++j) {
                 Event event;
-                event.id = "producer_" + std::to_string(i) + "_event_" + std::to_string(j);
+                event.id = static_cast<EventId>(i) * events_per_producer + j + 1;
                 event.type = "producer_event";
                 event.source = "producer_" + std::to_string(i);
                 event.data["producer_id"] = i;
@@ -108,3 +108,510 @@ TEST_F(EventQueueTest, MultiThreadedProducerConsumer) {
     ASSERT_EQ(popped_count, total_events);
     ASSERT_TRUE(queue.isEmpty());
 }
+
+// Test fixture cho EventQueue với backend LockFree (ring buffer nhỏ để dễ chạm giới hạn)
+class LockFreeEventQueueTest : public ::testing::Test {
+protected:
+    LockFreeEventQueueTest() : queue(EventQueue::Backend::LockFree, 8) {}
+    EventQueue queue;
+};
+
+// Test case: Push và Pop giữ nguyên thứ tự FIFO với backend LockFree
+TEST_F(LockFreeEventQueueTest, PushAndPopPreservesOrder) {
+    ASSERT_EQ(queue.backend(), EventQueue::Backend::LockFree);
+    for (int i = 0; i < 5; ++i) {
+        Event event;
+        event.id = i;
+        queue.push(event);
+    }
+    ASSERT_EQ(queue.size(), 5);
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(queue.pop().id, static_cast<EventId>(i));
+    }
+    ASSERT_TRUE(queue.isEmpty());
+    ASSERT_FALSE(queue.tryPop().has_value());
+}
+
+// Test case: Capacity không phải lũy thừa của 2 bị từ chối
+TEST(LockFreeEventQueueConfigTest, RejectsInvalidCapacity) {
+    ASSERT_THROW(EventQueue(EventQueue::Backend::LockFree, 100), std::invalid_argument);
+    ASSERT_THROW(EventQueue(EventQueue::Backend::LockFree, 1), std::invalid_argument);
+}
+
+// Test case: push() chờ khi ring buffer đầy và tiếp tục khi consumer lấy bớt Event
+TEST_F(LockFreeEventQueueTest, PushWaitsWhenFull) {
+    for (int i = 0; i < 8; ++i) {
+        queue.push(Event{});
+    }
+    ASSERT_EQ(queue.size(), 8);
+
+    std::atomic<bool> pushed = false;
+    std::thread producer([&]() {
+        queue.push(Event{});
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_FALSE(pushed); // Vẫn đang chờ slot trống
+
+    queue.pop();
+    producer.join();
+    ASSERT_TRUE(pushed);
+    ASSERT_EQ(queue.size(), 8);
+}
+
+// Test case: pop() blocking được đánh thức khi producer đẩy Event
+TEST_F(LockFreeEventQueueTest, BlockingPopWakesUpOnPush) {
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        Event event;
+        event.id = 7;
+        queue.push(event);
+    });
+
+    Event popped = queue.pop();
+    producer.join();
+    ASSERT_EQ(popped.id, 7u);
+}
+
+// Test case: Nhiều producer và nhiều consumer, không mất hoặc nhân đôi Event
+TEST_F(LockFreeEventQueueTest, MultiThreadedProducerConsumer) {
+    const int num_producers = 4;
+    const int num_consumers = 4;
+    const int events_per_producer = 1000;
+    const int total_events = num_producers * events_per_producer;
+
+    std::atomic<int> popped_count = 0;
+    std::atomic<long long> checksum = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < events_per_producer; ++j) {
+                Event event;
+                event.data["value"] = i * events_per_producer + j;
+                queue.push(std::move(event));
+            }
+        });
+    }
+    for (int i = 0; i < num_consumers; ++i) {
+        threads.emplace_back([&]() {
+            while (popped_count < total_events) {
+                auto opt_event = queue.tryPop();
+                if (opt_event) {
+                    checksum += std::get<int>(opt_event->data["value"]);
+                    popped_count++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    ASSERT_EQ(popped_count, total_events);
+    ASSERT_EQ(checksum, static_cast<long long>(total_events - 1) * total_events / 2);
+    ASSERT_TRUE(queue.isEmpty());
+}
+
+// Test case: popBatch lấy tối đa max_n Event theo đúng thứ tự
+TEST_F(EventQueueTest, PopBatchDrainsUpToMaxEvents) {
+    for (int i = 0; i < 10; ++i) {
+        Event event;
+        event.id = i;
+        queue.push(event);
+    }
+
+    std::vector<Event> batch;
+    ASSERT_EQ(queue.popBatch(batch, 4, std::chrono::milliseconds(0)), 4);
+    ASSERT_EQ(batch.size(), 4);
+    ASSERT_EQ(batch.front().id, 0u);
+    ASSERT_EQ(batch.back().id, 3u);
+
+    // Lần gọi thứ hai nối thêm vào vector và chỉ lấy những gì còn lại
+    ASSERT_EQ(queue.popBatch(batch, 100, std::chrono::milliseconds(0)), 6);
+    ASSERT_EQ(batch.size(), 10);
+    ASSERT_EQ(batch.back().id, 9u);
+    ASSERT_TRUE(queue.isEmpty());
+}
+
+// Test case: popBatch trả về 0 khi hết thời gian chờ trên hàng đợi trống
+TEST_F(EventQueueTest, PopBatchTimesOutOnEmptyQueue) {
+    std::vector<Event> batch;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(queue.popBatch(batch, 8, std::chrono::milliseconds(20)), 0);
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    ASSERT_TRUE(batch.empty());
+}
+
+// Test case: popBatch với backend LockFree được đánh thức khi có Event mới
+TEST_F(LockFreeEventQueueTest, PopBatchWakesUpOnPush) {
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.push(Event{});
+        queue.push(Event{});
+    });
+
+    std::vector<Event> batch;
+    size_t count = 0;
+    while (count < 2) {
+        count += queue.popBatch(batch, 8, std::chrono::seconds(1));
+    }
+    producer.join();
+    ASSERT_EQ(batch.size(), 2);
+    ASSERT_TRUE(queue.isEmpty());
+}
+
+// Test case: popFor trả về nullopt khi hết thời gian chờ
+TEST_F(EventQueueTest, PopForTimesOut) {
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(queue.popFor(std::chrono::milliseconds(20)).has_value());
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+// Test case: popUntil được đánh thức ngay khi có Event, không chờ đến deadline
+TEST_F(EventQueueTest, PopUntilWakesUpOnPush) {
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        Event event;
+        event.id = 11;
+        queue.push(event);
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    auto opt_event = queue.popUntil(start + std::chrono::seconds(10));
+    producer.join();
+    ASSERT_TRUE(opt_event.has_value());
+    ASSERT_EQ(opt_event->id, 11u);
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+// Test case: close() đánh thức consumer đang chờ, từ chối push và vẫn cho lấy nốt Event còn lại
+TEST_F(EventQueueTest, CloseWakesWaitersAndDrains) {
+    Event event;
+    event.id = 12;
+    ASSERT_TRUE(queue.push(event));
+    ASSERT_TRUE(queue.popFor(std::chrono::milliseconds(0)).has_value());
+
+    std::thread closer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.close();
+    });
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(queue.popFor(std::chrono::seconds(10)).has_value());
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    closer.join();
+
+    ASSERT_TRUE(queue.isClosed());
+    ASSERT_FALSE(queue.push(event));
+    ASSERT_THROW(queue.pop(), std::runtime_error);
+}
+
+// Test case: close() với backend LockFree: Event còn lại vẫn được lấy trước khi báo cạn
+TEST_F(LockFreeEventQueueTest, CloseDrainsRemainingEvents) {
+    queue.push(Event{});
+    queue.push(Event{});
+    queue.close();
+
+    ASSERT_FALSE(queue.push(Event{}));
+    std::vector<Event> batch;
+    ASSERT_EQ(queue.popBatch(batch, 8, std::chrono::seconds(10)), 2);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(queue.popBatch(batch, 8, std::chrono::seconds(10)), 0);
+    ASSERT_FALSE(queue.popFor(std::chrono::seconds(10)).has_value());
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+// Test case: close() đánh thức consumer LockFree đang ngủ trong popFor
+TEST_F(LockFreeEventQueueTest, CloseWakesSleepingConsumer) {
+    std::thread closer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.close();
+    });
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(queue.popFor(std::chrono::seconds(10)).has_value());
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    closer.join();
+}
+
+// Tạo hàng đợi backend Mutex có giới hạn với chính sách khi đầy cho trước
+static EventQueue::Options boundedOptions(EventQueue::OverflowPolicy policy, size_t capacity) {
+    EventQueue::Options options;
+    options.capacity = capacity;
+    options.overflow_policy = policy;
+    return options;
+}
+
+static Event makeEvent(EventId id) {
+    Event event;
+    event.id = id;
+    return event;
+}
+
+// Test case: DropNewest từ chối Event mới khi đầy và đếm số Event bị bỏ
+TEST(BoundedEventQueueTest, DropNewestRejectsWhenFull) {
+    EventQueue queue(boundedOptions(EventQueue::OverflowPolicy::DropNewest, 2));
+    ASSERT_TRUE(queue.push(makeEvent(1)));
+    ASSERT_TRUE(queue.push(makeEvent(2)));
+    ASSERT_FALSE(queue.push(makeEvent(3)));
+
+    ASSERT_EQ(queue.size(), 2);
+    ASSERT_EQ(queue.pop().id, 1u);
+    ASSERT_EQ(queue.stats().admitted, 2);
+    ASSERT_EQ(queue.stats().dropped_newest, 1);
+}
+
+// Test case: DropOldest bỏ Event cũ nhất để nhận Event mới
+TEST(BoundedEventQueueTest, DropOldestEvictsHead) {
+    EventQueue queue(boundedOptions(EventQueue::OverflowPolicy::DropOldest, 2));
+    ASSERT_TRUE(queue.push(makeEvent(1)));
+    ASSERT_TRUE(queue.push(makeEvent(2)));
+    ASSERT_TRUE(queue.push(makeEvent(3)));
+
+    ASSERT_EQ(queue.size(), 2);
+    ASSERT_EQ(queue.pop().id, 2u);
+    ASSERT_EQ(queue.pop().id, 3u);
+    ASSERT_EQ(queue.stats().dropped_oldest, 1);
+}
+
+// Test case: Block chặn producer cho đến khi consumer lấy bớt Event
+TEST(BoundedEventQueueTest, BlockWaitsForSpace) {
+    EventQueue queue(boundedOptions(EventQueue::OverflowPolicy::Block, 1));
+    ASSERT_TRUE(queue.push(makeEvent(1)));
+
+    std::atomic<bool> pushed = false;
+    std::thread producer([&]() {
+        pushed = queue.push(makeEvent(2));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_FALSE(pushed);
+
+    ASSERT_EQ(queue.pop().id, 1u);
+    producer.join();
+    ASSERT_TRUE(pushed);
+    ASSERT_EQ(queue.pop().id, 2u);
+    ASSERT_EQ(queue.stats().blocked_pushes, 1);
+}
+
+// Test case: close() giải phóng producer đang bị chặn
+TEST(BoundedEventQueueTest, CloseReleasesBlockedProducer) {
+    EventQueue queue(boundedOptions(EventQueue::OverflowPolicy::Block, 1));
+    ASSERT_TRUE(queue.push(makeEvent(1)));
+
+    std::atomic<bool> result = true;
+    std::thread producer([&]() {
+        result = queue.push(makeEvent(2));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    producer.join();
+    ASSERT_FALSE(result);
+    ASSERT_EQ(queue.stats().rejected_closed, 1);
+}
+
+// Test case: Sample luôn nhận dưới ngưỡng, không bao giờ vượt dung lượng và đếm Event bị loại
+TEST(BoundedEventQueueTest, SampleKeepsQueueBounded) {
+    EventQueue::Options options = boundedOptions(EventQueue::OverflowPolicy::Sample, 100);
+    options.sample_threshold = 0.5;
+    EventQueue queue(options);
+
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(queue.push(makeEvent(1)));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        queue.push(makeEvent(2));
+    }
+    EventQueue::Stats stats = queue.stats();
+    ASSERT_LE(queue.size(), 100);
+    ASSERT_EQ(stats.admitted, queue.size());
+    ASSERT_EQ(stats.admitted + stats.dropped_sampled + stats.dropped_newest, 1050);
+    ASSERT_GT(stats.dropped_sampled, 0);
+}
+
+// Test case: DropOldest với backend LockFree
+TEST(BoundedEventQueueTest, LockFreeDropOldest) {
+    EventQueue::Options options = boundedOptions(EventQueue::OverflowPolicy::DropOldest, 4);
+    options.backend = EventQueue::Backend::LockFree;
+    EventQueue queue(options);
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_TRUE(queue.push(makeEvent(i)));
+    }
+    ASSERT_EQ(queue.stats().dropped_oldest, 2);
+    ASSERT_EQ(queue.pop().id, 2u);
+}
+
+// Test case: pushBatch đẩy cả lô theo thứ tự, áp dụng OverflowPolicy cho từng Event và xóa vector
+TEST(BoundedEventQueueTest, PushBatchAppliesPolicyPerEvent) {
+    for (auto backend : {EventQueue::Backend::Mutex, EventQueue::Backend::LockFree}) {
+        EventQueue::Options options = boundedOptions(EventQueue::OverflowPolicy::DropNewest, 4);
+        options.backend = backend;
+        EventQueue queue(options);
+
+        std::vector<Event> batch;
+        for (int i = 1; i <= 6; ++i) {
+            batch.push_back(makeEvent(i));
+        }
+        ASSERT_EQ(queue.pushBatch(batch), 4u);
+        ASSERT_TRUE(batch.empty());
+        ASSERT_EQ(queue.stats().admitted, 4);
+        ASSERT_EQ(queue.stats().dropped_newest, 2);
+        for (EventId id = 1; id <= 4; ++id) {
+            ASSERT_EQ(queue.pop().id, id);
+        }
+    }
+}
+
+// Test case: Event bị từ chối được trả lại cho caller (pushBatch với 'rejected', pushOrKeep)
+TEST(BoundedEventQueueTest, RejectedEventsAreReturnedToCaller) {
+    for (auto backend : {EventQueue::Backend::Mutex, EventQueue::Backend::LockFree}) {
+        EventQueue::Options options = boundedOptions(EventQueue::OverflowPolicy::DropNewest, 2);
+        options.backend = backend;
+        EventQueue queue(options);
+
+        std::vector<Event> batch;
+        for (int i = 1; i <= 4; ++i) {
+            batch.push_back(makeEvent(i));
+        }
+        std::vector<Event> rejected;
+        ASSERT_EQ(queue.pushBatch(batch, &rejected), 2u);
+        ASSERT_TRUE(batch.empty());
+        ASSERT_EQ(rejected.size(), 2u);
+        ASSERT_EQ(rejected[0].id, 3u);
+        ASSERT_EQ(rejected[1].id, 4u);
+
+        Event event = makeEvent(5);
+        ASSERT_FALSE(queue.pushOrKeep(event));
+        ASSERT_EQ(event.id, 5u); // Event không bị move khi bị từ chối
+    }
+}
+
+// Test case: pushBatch với Block không bị treo khi chính lô đó làm đầy hàng đợi
+TEST(BoundedEventQueueTest, PushBatchBlockWakesConsumer) {
+    EventQueue queue(boundedOptions(EventQueue::OverflowPolicy::Block, 2));
+    std::vector<EventId> received;
+    std::thread consumer([&]() {
+        while (auto event = queue.popFor(std::chrono::seconds(2))) {
+            received.push_back(event->id);
+            if (received.size() == 5) {
+                break;
+            }
+        }
+    });
+    std::vector<Event> batch;
+    for (int i = 1; i <= 5; ++i) {
+        batch.push_back(makeEvent(i));
+    }
+    ASSERT_EQ(queue.pushBatch(batch), 5u);
+    consumer.join();
+    ASSERT_EQ(received, (std::vector<EventId>{1, 2, 3, 4, 5}));
+}
+
+// Cấu hình hai lane: "alert" và nguồn "critical_" vào lane 0, còn lại vào lane 1
+static EventQueue::Options laneOptions(EventQueue::Backend backend, EventQueue::LaneScheduling scheduling) {
+    EventQueue::Options options;
+    options.backend = backend;
+    options.capacity = backend == EventQueue::Backend::LockFree ? 64 : 0;
+    options.lanes.count = 2;
+    options.lanes.by_type = {{"alert", 0}};
+    options.lanes.by_source_prefix = {{"critical_", 0}};
+    options.lanes.default_lane = 1;
+    options.lanes.scheduling = scheduling;
+    if (scheduling == EventQueue::LaneScheduling::Weighted) {
+        options.lanes.weights = {3, 1};
+    }
+    return options;
+}
+
+// ID dùng để phân biệt Event của lane cao và lane thấp
+static constexpr EventId kHigh = 100;
+static constexpr EventId kLow = 200;
+
+static Event makeLaneEvent(EventId id, const std::string& type, const std::string& source) {
+    Event event = makeEvent(id);
+    event.type = type;
+    event.source = source;
+    return event;
+}
+
+// Test case: Event được xếp lane theo type trước, sau đó theo tiền tố source
+TEST(EventQueueLaneTest, MapsEventsToLanes) {
+    EventQueue queue(laneOptions(EventQueue::Backend::Mutex, EventQueue::LaneScheduling::StrictPriority));
+    ASSERT_EQ(queue.laneCount(), 2);
+    ASSERT_EQ(queue.laneFor(makeLaneEvent(1, "alert", "socket")), 0);
+    ASSERT_EQ(queue.laneFor(makeLaneEvent(2, "reading", "critical_sensor")), 0);
+    ASSERT_EQ(queue.laneFor(makeLaneEvent(3, "heartbeat", "timer")), 1);
+}
+
+// Test case: StrictPriority luôn lấy lane ưu tiên cao trước, FIFO trong từng lane
+TEST(EventQueueLaneTest, StrictPriorityServesHighLaneFirst) {
+    for (auto backend : {EventQueue::Backend::Mutex, EventQueue::Backend::LockFree}) {
+        EventQueue queue(laneOptions(backend, EventQueue::LaneScheduling::StrictPriority));
+        queue.push(makeLaneEvent(3, "heartbeat", "timer"));
+        queue.push(makeLaneEvent(4, "heartbeat", "timer"));
+        queue.push(makeLaneEvent(1, "alert", "socket"));
+        queue.push(makeLaneEvent(2, "reading", "critical_sensor"));
+        ASSERT_EQ(queue.laneSize(0), 2);
+        ASSERT_EQ(queue.laneSize(1), 2);
+
+        std::vector<Event> batch;
+        ASSERT_EQ(queue.popBatch(batch, 10, std::chrono::milliseconds(0)), 4);
+        ASSERT_EQ(batch[0].id, 1u);
+        ASSERT_EQ(batch[1].id, 2u);
+        ASSERT_EQ(batch[2].id, 3u);
+        ASSERT_EQ(batch[3].id, 4u);
+    }
+}
+
+// Test case: Weighted chia lượt 3:1 khi cả hai lane có Event, lane trống nhường lượt
+TEST(EventQueueLaneTest, WeightedSharesTurns) {
+    EventQueue queue(laneOptions(EventQueue::Backend::Mutex, EventQueue::LaneScheduling::Weighted));
+    for (int i = 0; i < 8; ++i) {
+        queue.push(makeLaneEvent(kHigh, "alert", "socket"));
+        queue.push(makeLaneEvent(kLow, "heartbeat", "timer"));
+    }
+    int high = 0;
+    for (int i = 0; i < 8; ++i) {
+        if (queue.pop().id == kHigh) {
+            ++high;
+        }
+    }
+    ASSERT_EQ(high, 6);
+    // Lane cao còn 2 Event, lane thấp còn 6: lấy hết mà không bị kẹt ở lane trống
+    ASSERT_EQ(queue.size(), 8);
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(queue.tryPop().has_value());
+    }
+    ASSERT_TRUE(queue.isEmpty());
+}
+
+// Test case: Dung lượng áp dụng cho từng lane, lane ồn ào không chiếm chỗ của lane ưu tiên
+TEST(EventQueueLaneTest, CapacityIsPerLane) {
+    EventQueue::Options options = laneOptions(EventQueue::Backend::Mutex, EventQueue::LaneScheduling::StrictPriority);
+    options.capacity = 2;
+    options.overflow_policy = EventQueue::OverflowPolicy::DropNewest;
+    EventQueue queue(options);
+    for (int i = 0; i < 5; ++i) {
+        queue.push(makeLaneEvent(kLow, "heartbeat", "timer"));
+    }
+    ASSERT_TRUE(queue.push(makeLaneEvent(kHigh, "alert", "socket")));
+    ASSERT_EQ(queue.laneSize(1), 2);
+    ASSERT_EQ(queue.stats().dropped_newest, 3);
+    ASSERT_EQ(queue.pop().id, kHigh);
+}
+
+// Test case: Cấu hình lane không hợp lệ ném ngoại lệ
+TEST(EventQueueLaneTest, RejectsInvalidLaneOptions) {
+    EventQueue::Options options;
+    options.lanes.count = 2;
+    options.lanes.by_type = {{"alert", 2}};
+    ASSERT_THROW(EventQueue{options}, std::invalid_argument);
+
+    options.lanes.by_type.clear();
+    options.lanes.scheduling = EventQueue::LaneScheduling::Weighted;
+    options.lanes.weights = {1};
+    ASSERT_THROW(EventQueue{options}, std::invalid_argument);
+}
@@ -0,0 +1,102 @@
+// tests/IngestFilterTest.cpp
+#include "gtest/gtest.h"
+#include "rules/RuleManager.h"
+#include "rules/RuleParser.h"
+#include "core/EventProcessor.h"
+#include "core/EventQueue.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <cstdio>
+
+// Ghi bộ quy tắc ra file tạm và tải vào RuleManager
+static void loadRulesFromJson(const std::string& rules) {
+    const std::string path = "ingest_filter_test_rules.json";
+    {
+        std::ofstream file(path);
+        file << rules;
+    }
+    RuleManager::getInstance().loadRules(path);
+    std::remove(path.c_str());
+}
+
+static Event makeEvent(const std::string& type, const std::string& source, const std::string& key) {
+    Event event;
+    event.type = type;
+    event.source = source;
+    event.data[key] = 1;
+    return event;
+}
+
+// Test case: AND lấy key bắt buộc của điều kiện con, OR lấy hợp, NOT không suy ra được
+TEST(IngestFilterTest, RequiredKeysFromConditionTree) {
+    auto rule = RuleParser::parse(nlohmann::json::parse(R"({
+        "id": "r", "actions": [],
+        "condition": {"and": [
+            {"or": [{"key": "a", "operator": "==", "value": 1}, {"key": "b", "operator": "==", "value": 1}]},
+            {"key": "c", "operator": ">", "value": 0}
+        ]}
+    })"));
+    std::vector<KeyId> keys;
+    ASSERT_TRUE(rule->collectRequiredKeys(keys));
+    ASSERT_EQ(keys, (std::vector<KeyId>{KeyRegistry::intern("c")})); // Tập nhỏ nhất của AND
+
+    auto not_rule = RuleParser::parse(nlohmann::json::parse(R"({
+        "id": "n", "actions": [], "condition": {"not": {"key": "a", "operator": "==", "value": 1}}
+    })"));
+    keys.clear();
+    ASSERT_FALSE(not_rule->collectRequiredKeys(keys));
+}
+
+// Test case: RuleManager xuất IngestFilter theo key, type và nguồn; làm mới khi loadRules
+TEST(IngestFilterTest, RuleManagerExportsAndRefreshesFilter) {
+    // Listener sống lâu hơn test (RuleManager là Singleton) nên chỉ giữ bản sao của shared_ptr
+    auto latest = std::make_shared<std::shared_ptr<const IngestFilter>>();
+    RuleManager::getInstance().subscribeIngestFilter([latest](std::shared_ptr<const IngestFilter> filter) {
+        *latest = std::move(filter);
+    });
+    const auto& received = *latest;
+
+    loadRulesFromJson(R"([
+        {"id": "temp", "condition": {"key": "temperature", "operator": ">", "value": 30}, "actions": []},
+        {"id": "door", "event_types": ["door_event"], "sources": ["sensor/"],
+         "condition": {"key": "open", "operator": "==", "value": true}, "actions": []}
+    ])");
+    ASSERT_NE(received, nullptr);
+    ASSERT_EQ(received, RuleManager::getInstance().getIngestFilter());
+
+    ASSERT_TRUE(received->accepts(makeEvent("reading", "socket/1", "temperature")));
+    ASSERT_FALSE(received->accepts(makeEvent("network_data", "socket/1", "client_ip")));
+    ASSERT_TRUE(received->accepts(makeEvent("door_event", "sensor/front", "open")));
+    ASSERT_FALSE(received->accepts(makeEvent("door_event", "socket/1", "open")));  // Sai nguồn
+    ASSERT_FALSE(received->accepts(makeEvent("other", "sensor/front", "open")));   // Sai type
+
+    // Một quy tắc chỉ có NOT khiến mọi Event đều có thể khớp
+    loadRulesFromJson(R"([
+        {"id": "not_only", "condition": {"not": {"key": "ok", "operator": "==", "value": true}}, "actions": []}
+    ])");
+    ASSERT_TRUE(received->accepts(makeEvent("network_data", "socket/1", "client_ip")));
+}
+
+// Test case: EventProcessor loại Event không thể khớp, bỏ qua phân tích với nguồn không liên quan
+TEST(IngestFilterTest, EventProcessorDropsUnmatchableEvents) {
+    IngestFilter::Scope scope;
+    scope.source_prefixes = {"sensor/"};
+    scope.any_key = false;
+    scope.keys = {KeyRegistry::intern("temperature")};
+    auto filter = std::make_shared<const IngestFilter>(std::vector<IngestFilter::Scope>{scope});
+
+    EventQueue queue;
+    EventProcessor processor(queue);
+    processor.setIngestFilter(filter);
+
+    ASSERT_TRUE(processor.processRawJsonData("sensor/1", R"({"temperature": 31})"));
+    ASSERT_FALSE(processor.processRawJsonData("sensor/1", R"({"humidity": 50})"));
+    ASSERT_FALSE(processor.processRawJsonData("socket/1", "not even json")); // Không được phân tích
+    ASSERT_FALSE(processor.processRawData("sensor/1", "reading", 5, "humidity"));
+    ASSERT_EQ(processor.processRawJsonBatch("socket/1", "{\"temperature\": 1}\n{\"temperature\": 2}\n"), 0u);
+    ASSERT_EQ(processor.filteredCount(), 5u);
+    ASSERT_EQ(queue.size(), 1);
+
+    processor.setIngestFilter(nullptr); // Không có filter: nhận mọi Event
+    ASSERT_TRUE(processor.processRawData("socket/1", "reading", 5, "humidity"));
+}
@@ -0,0 +1,89 @@
+// tests/IngestionStageTest.cpp
+#include "gtest/gtest.h"
+#include "core/IngestionStage.h"
+#include "core/EventProcessor.h"
+#include "core/EventQueue.h"
+#include <map>
+#include <string>
+
+// Tạo payload JSON có trường "seq" để kiểm tra thứ tự
+static std::string seqJson(int seq) {
+    return "{\"type\": \"reading\", \"seq\": " + std::to_string(seq) + "}";
+}
+
+// Test case: nhiều worker phân tích mọi payload và đẩy đủ Event vào hàng đợi
+TEST(IngestionStageTest, WorkersParseAllPayloads) {
+    EventQueue queue;
+    EventProcessor processor(queue);
+    IngestionStage::Options options;
+    options.workers = 4;
+    options.capacity = 16; // Nhỏ để submit phải chờ worker giải phóng chỗ
+    {
+        IngestionStage stage(processor, options);
+        ASSERT_EQ(stage.workerCount(), 4u);
+        for (int i = 0; i < 200; ++i) {
+            ASSERT_TRUE(stage.submit("sensor", seqJson(i)));
+        }
+        stage.stop(); // Xử lý nốt payload còn lại
+        ASSERT_EQ(stage.stats().submitted, 200);
+        ASSERT_EQ(stage.stats().processed, 200);
+        ASSERT_EQ(stage.stats().events_admitted, 200);
+    }
+    ASSERT_EQ(queue.size(), 200);
+}
+
+// Test case: preserve_source_order giữ thứ tự Event của từng nguồn
+TEST(IngestionStageTest, PreservesPerSourceOrder) {
+    EventQueue queue;
+    EventProcessor processor(queue);
+    IngestionStage::Options options;
+    options.workers = 4;
+    options.preserve_source_order = true;
+    IngestionStage stage(processor, options);
+
+    const std::vector<std::string> sources = {"socket/1", "socket/2", "socket/3"};
+    for (int i = 0; i < 100; ++i) {
+        for (const auto& source : sources) {
+            ASSERT_TRUE(stage.submit(source, seqJson(i)));
+        }
+    }
+    stage.stop();
+
+    std::map<std::string, int> last_seq;
+    while (!queue.isEmpty()) {
+        Event event = queue.pop();
+        int seq = std::get<int>(*event.data.get("seq"));
+        auto it = last_seq.find(event.source);
+        if (it != last_seq.end()) {
+            ASSERT_EQ(seq, it->second + 1) << "Out of order for " << event.source;
+        }
+        last_seq[event.source] = seq;
+    }
+    ASSERT_EQ(last_seq.size(), sources.size());
+}
+
+// Test case: payload NDJSON được tách thành nhiều Event; submit bị từ chối sau stop()
+TEST(IngestionStageTest, NdjsonAndRejectAfterStop) {
+    EventQueue queue;
+    EventProcessor processor(queue);
+    IngestionStage::Options options;
+    options.workers = 1;
+    IngestionStage stage(processor, options);
+
+    ASSERT_TRUE(stage.submit("socket", seqJson(1) + "\n" + seqJson(2) + "\n", IngestionStage::Format::Ndjson));
+    stage.stop();
+    ASSERT_EQ(queue.size(), 2);
+    ASSERT_EQ(stage.stats().events_admitted, 2);
+
+    ASSERT_FALSE(stage.submit("socket", seqJson(3)));
+    ASSERT_EQ(stage.stats().rejected, 1);
+}
+
+// Test case: capacity không phải lũy thừa của 2 bị từ chối
+TEST(IngestionStageTest, RejectsInvalidCapacity) {
+    EventQueue queue;
+    EventProcessor processor(queue);
+    IngestionStage::Options options;
+    options.capacity = 100;
+    ASSERT_THROW(IngestionStage(processor, options), std::invalid_argument);
+}
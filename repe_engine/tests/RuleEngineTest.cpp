@@ -0,0 +1,219 @@
+// tests/RuleEngineTest.cpp
+#include "gtest/gtest.h"
+#include "core/RuleEngine.h"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Tạo Event có nguồn và số thứ tự trong nguồn đó
+static Event makeEvent(const std::string& source, int seq) {
+    Event event;
+    event.source = source;
+    event.data["seq"] = seq;
+    return event;
+}
+
+// Test case: Nhiều worker xử lý song song nhưng Event của cùng một nguồn luôn theo thứ tự, trên cùng một worker
+TEST(RuleEngineTest, PreservesOrderWithinPartition) {
+    EventQueue input;
+    std::mutex mutex;
+    std::map<std::string, std::vector<int>> seen;
+    std::map<std::string, std::set<size_t>> workers_by_source;
+
+    RuleEngine::Options options;
+    options.workers = 4;
+    options.batch_size = 8;
+    options.worker_queue_capacity = 16; // Nhỏ để router phải chờ worker (áp lực ngược)
+    RuleEngine engine(input, [&](std::vector<Event>& batch, size_t worker) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& event : batch) {
+            seen[event.source].push_back(std::get<int>(*event.data.get(KeyRegistry::intern("seq"))));
+            workers_by_source[event.source].insert(worker);
+        }
+    }, options);
+    ASSERT_EQ(engine.workerCount(), 4u);
+
+    const int kSources = 16;
+    const int kPerSource = 200;
+    for (int i = 0; i < kPerSource; ++i) {
+        for (int s = 0; s < kSources; ++s) {
+            input.push(makeEvent("sensor_" + std::to_string(s), i));
+        }
+    }
+    engine.stop(); // Đóng đầu vào, xử lý nốt mọi Event
+
+    ASSERT_EQ(engine.processedCount(), static_cast<uint64_t>(kSources * kPerSource));
+    ASSERT_EQ(seen.size(), static_cast<size_t>(kSources));
+    std::set<size_t> used_workers;
+    for (const auto& [source, seqs] : seen) {
+        ASSERT_EQ(seqs.size(), static_cast<size_t>(kPerSource));
+        for (int i = 0; i < kPerSource; ++i) {
+            ASSERT_EQ(seqs[i], i) << "Out of order for " << source;
+        }
+        ASSERT_EQ(workers_by_source[source].size(), 1u);
+        used_workers.insert(*workers_by_source[source].begin());
+    }
+    ASSERT_GT(used_workers.size(), 1u); // Các nguồn được chia cho nhiều worker
+}
+
+// Test case: Phân vùng theo key dữ liệu; Event thiếu key rơi về phân vùng theo nguồn
+TEST(RuleEngineTest, PartitionsByConfiguredKey) {
+    EventQueue input;
+    RuleEngine::Options options;
+    options.workers = 8;
+    options.partition_key = "device_id";
+    RuleEngine engine(input, [](std::vector<Event>&, size_t) {}, options);
+
+    Event a = makeEvent("socket/1", 0);
+    a.data["device_id"] = std::string("dev-42");
+    Event b = makeEvent("socket/2", 1);
+    b.data["device_id"] = std::string("dev-42");
+    ASSERT_EQ(engine.partitionFor(a), engine.partitionFor(b)); // Cùng thiết bị, khác nguồn
+
+    Event no_key = makeEvent("socket/3", 2);
+    Event same_source = makeEvent("socket/3", 3);
+    ASSERT_EQ(engine.partitionFor(no_key), engine.partitionFor(same_source));
+}
+
+// Test case: Một worker đọc thẳng hàng đợi đầu vào; stop() an toàn khi gọi nhiều lần
+TEST(RuleEngineTest, SingleWorkerDrainsInput) {
+    EventQueue input;
+    std::vector<int> seqs;
+    RuleEngine::Options options;
+    options.workers = 1;
+    RuleEngine engine(input, [&](std::vector<Event>& batch, size_t worker) {
+        ASSERT_EQ(worker, 0u);
+        for (const auto& event : batch) {
+            seqs.push_back(std::get<int>(*event.data.get(KeyRegistry::intern("seq"))));
+        }
+    }, options);
+
+    for (int i = 0; i < 100; ++i) {
+        input.push(makeEvent("s", i));
+    }
+    engine.stop();
+    engine.stop();
+
+    ASSERT_EQ(seqs.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(seqs[i], i);
+    }
+}
+
+// Test case: Với nhiều worker, Event lane 0 không bị kẹt sau phần tồn đọng của lane thấp
+// (hàng đợi worker giữ lane của hàng đợi đầu vào và chỉ chứa vài lô)
+TEST(RuleEngineTest, HighLaneOvertakesLowLaneBacklogWithWorkers) {
+    EventQueue::Options queue_options;
+    queue_options.lanes.count = 2;
+    queue_options.lanes.by_type["alarm"] = 0;
+    queue_options.lanes.default_lane = 1;
+    EventQueue input(queue_options);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool started = false;
+    bool released = false;
+    std::vector<std::string> order;
+
+    RuleEngine::Options options;
+    options.workers = 2;
+    options.batch_size = 8;
+    options.partition_key = "device"; // Mọi Event cùng một worker
+    RuleEngine engine(input, [&](std::vector<Event>& batch, size_t) {
+        std::unique_lock<std::mutex> lock(mutex);
+        started = true;
+        cv.notify_all();
+        cv.wait(lock, [&] { return released; }); // Worker bận với lô đầu tiên cho đến khi được thả
+        for (const auto& event : batch) {
+            order.push_back(event.type);
+        }
+    }, options);
+
+    const int kBacklog = 1000;
+    for (int i = 0; i < kBacklog; ++i) {
+        Event event = makeEvent("bulk", i);
+        event.type = "bulk";
+        event.data["device"] = std::string("d1");
+        input.push(std::move(event));
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return started; });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Router đẩy vào hàng đợi worker đến khi đầy
+
+    Event alarm = makeEvent("alarm", 0);
+    alarm.type = "alarm";
+    alarm.data["device"] = std::string("d1");
+    input.push(std::move(alarm));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+    }
+    cv.notify_all();
+    engine.stop();
+
+    ASSERT_EQ(order.size(), static_cast<size_t>(kBacklog + 1));
+    size_t alarm_position = 0;
+    while (alarm_position < order.size() && order[alarm_position] != "alarm") {
+        ++alarm_position;
+    }
+    // Trước alarm chỉ có lô đang xử lý, hàng đợi worker (2 lô) và lô router đang đẩy
+    ASSERT_LT(alarm_position, 5 * options.batch_size);
+}
+
+// Test case: Với nhiều lane, Event cùng khóa vẫn do một worker xử lý và giữ thứ tự trong từng lane
+// (giữa các lane thì lane ưu tiên thắng nên không kiểm tra thứ tự xen kẽ)
+TEST(RuleEngineTest, PreservesOrderWithinLanePerPartition) {
+    EventQueue::Options queue_options;
+    queue_options.lanes.count = 2;
+    queue_options.lanes.by_type["alarm"] = 0;
+    queue_options.lanes.default_lane = 1;
+    EventQueue input(queue_options);
+
+    std::mutex mutex;
+    std::map<std::string, std::vector<int>> seen; // "nguồn/type" -> các seq theo thứ tự xử lý
+    std::map<std::string, std::set<size_t>> workers_by_source;
+
+    RuleEngine::Options options;
+    options.workers = 4;
+    options.batch_size = 8;
+    RuleEngine engine(input, [&](std::vector<Event>& batch, size_t worker) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& event : batch) {
+            seen[event.source + "/" + event.type].push_back(
+                std::get<int>(*event.data.get(KeyRegistry::intern("seq"))));
+            workers_by_source[event.source].insert(worker);
+        }
+    }, options);
+
+    const int kSources = 8;
+    const int kPerLane = 300;
+    for (int i = 0; i < kPerLane; ++i) {
+        for (int s = 0; s < kSources; ++s) {
+            for (const char* type : {"bulk", "alarm"}) {
+                Event event = makeEvent("sensor_" + std::to_string(s), i);
+                event.type = type;
+                input.push(std::move(event));
+            }
+        }
+    }
+    engine.stop();
+
+    ASSERT_EQ(engine.processedCount(), static_cast<uint64_t>(kSources * kPerLane * 2));
+    ASSERT_EQ(seen.size(), static_cast<size_t>(kSources * 2));
+    for (const auto& [key, seqs] : seen) {
+        ASSERT_EQ(seqs.size(), static_cast<size_t>(kPerLane));
+        for (int i = 0; i < kPerLane; ++i) {
+            ASSERT_EQ(seqs[i], i) << "Out of order for " << key;
+        }
+    }
+    for (const auto& [source, workers] : workers_by_source) {
+        ASSERT_EQ(workers.size(), 1u) << source;
+    }
+}
@@ -0,0 +1,111 @@
+// tests/RuleIndexTest.cpp
+#include "gtest/gtest.h"
+#include "rules/RuleIndex.h"
+#include "rules/RuleParser.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <string>
+
+static std::vector<Rule> parseRules(const nlohmann::json& rules_json) {
+    std::vector<Rule> rules;
+    for (const auto& rule_json : rules_json) {
+        rules.push_back(std::move(*RuleParser::parse(rule_json)));
+    }
+    return rules;
+}
+
+// Test case: Key trong "and" đều bắt buộc, "or" chỉ giữ key chung của mọi nhánh, "not" không có key bắt buộc
+TEST(RuleIndexTest, MandatoryKeysFromConditionTree) {
+    auto rule = RuleParser::parse(nlohmann::json::parse(R"({
+        "id": "r", "actions": [],
+        "condition": {"and": [
+            {"key": "a", "operator": "==", "value": 1},
+            {"or": [
+                {"and": [{"key": "b", "operator": "==", "value": 1}, {"key": "c", "operator": "==", "value": 1}]},
+                {"and": [{"key": "c", "operator": ">", "value": 5}, {"key": "d", "operator": "==", "value": 1}]}
+            ]},
+            {"not": {"key": "e", "operator": "==", "value": 1}}
+        ]}
+    })"));
+    std::vector<KeyId> expected{KeyRegistry::intern("a"), KeyRegistry::intern("c")};
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(rule->collectMandatoryKeys(), expected);
+}
+
+// Test case: Với hàng nghìn quy tắc theo thiết bị, một Event chỉ chạm tới vài quy tắc
+TEST(RuleIndexTest, DeviceSpecificRulesYieldFewCandidates) {
+    nlohmann::json rules_json = nlohmann::json::array();
+    for (int i = 0; i < 2000; ++i) {
+        rules_json.push_back({
+            {"id", "device_" + std::to_string(i)},
+            {"sources", {"device/" + std::to_string(i) + "/"}},
+            {"condition", {{"key", "temperature"}, {"operator", ">"}, {"value", 30}}},
+            {"actions", nlohmann::json::array()}
+        });
+    }
+    rules_json.push_back({{"id", "door"}, {"event_types", {"door_event"}},
+                          {"condition", {{"key", "open"}, {"operator", "==" }, {"value", true}}},
+                          {"actions", nlohmann::json::array()}});
+    rules_json.push_back({{"id", "humid"},
+                          {"condition", {{"or", {{{"key", "humidity"}, {"operator", ">"}, {"value", 80}},
+                                                 {{"key", "dew_point"}, {"operator", ">"}, {"value", 20}}}}}},
+                          {"actions", nlohmann::json::array()}});
+    rules_json.push_back({{"id", "not_ok"}, {"condition", {{"not", {{"key", "ok"}, {"operator", "=="}, {"value", true}}}}},
+                          {"actions", nlohmann::json::array()}});
+    std::vector<Rule> rules = parseRules(rules_json);
+    RuleIndex index(rules);
+
+    ASSERT_EQ(index.stats().by_source, 2000u);
+    ASSERT_EQ(index.stats().unindexed, 1u); // not_ok
+
+    Event event;
+    event.source = "device/42/sensor";
+    event.data["temperature"] = 35;
+    std::vector<size_t> candidates;
+    index.candidates(event, candidates);
+    ASSERT_EQ(candidates, (std::vector<size_t>{42, 2002}));
+
+    // Event có đủ key của một nhánh "or"; quy tắc theo type cần đúng Event::type
+    Event other;
+    other.type = "door_event";
+    other.source = "device/4/x";
+    other.data["dew_point"] = 25.0;
+    other.data["open"] = true;
+    candidates.clear();
+    index.candidates(other, candidates);
+    ASSERT_EQ(candidates, (std::vector<size_t>{2000, 2001, 2002})); // device_4 thiếu key temperature
+}
+
+// Test case: Ứng viên luôn bao gồm mọi quy tắc thực sự khớp
+TEST(RuleIndexTest, CandidatesCoverAllMatches) {
+    std::vector<Rule> rules = parseRules(nlohmann::json::parse(R"([
+        {"id": "a", "condition": {"and": [{"key": "x", "operator": ">", "value": 1}, {"key": "y", "operator": "==", "value": 2}]}, "actions": []},
+        {"id": "b", "condition": {"or": [{"key": "x", "operator": "<", "value": 1}, {"key": "z", "operator": "==", "value": 2}]}, "actions": []},
+        {"id": "c", "event_types": ["t1", "t2"], "condition": {"key": "y", "operator": "!=", "value": 0}, "actions": []},
+        {"id": "d", "sources": ["s/"], "condition": {"not": {"key": "x", "operator": "==", "value": 0}}, "actions": []},
+        {"id": "e", "condition": {"and": []}, "actions": []}
+    ])"));
+    RuleIndex index(rules);
+
+    std::vector<Event> events(4);
+    events[0].data["x"] = 5;
+    events[0].data["y"] = 2;
+    events[1].type = "t2";
+    events[1].source = "s/1";
+    events[1].data["y"] = 1;
+    events[1].data["z"] = 2;
+    events[2].source = "s/";
+    events[3].type = "t1";
+    events[3].data["x"] = 0;
+
+    for (const auto& event : events) {
+        std::vector<size_t> candidates;
+        index.candidates(event, candidates);
+        for (size_t i = 0; i < rules.size(); ++i) {
+            if (rules[i].check(event)) {
+                ASSERT_TRUE(std::find(candidates.begin(), candidates.end(), i) != candidates.end())
+                    << "Rule " << rules[i].getId() << " missing from candidates";
+            }
+        }
+    }
+}
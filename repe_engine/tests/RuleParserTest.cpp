@@ -6,11 +6,18 @@
 #include "rules/conditions/LogicalConditions.h"
 #include "common/Event.h"
 #include <nlohmann/json.hpp>
+#include <stdexcept>
+
+// Định nghĩa trong actions/ActionFactory.cpp.
+extern void registerAllDefaultActions();
 
 // Test fixture cho RuleParser
 class RuleParserTest : public ::testing::Test {
 protected:
-    // Có thể khởi tạo các đối tượng chung nếu cần
+    void SetUp() override {
+        // RuleParser tạo sẵn hành động của quy tắc nên các loại hành động phải được đăng ký.
+        registerAllDefaultActions();
+    }
 };
 
 // Test case: Parse một Rule đơn giản với ValueCondition
@@ -191,3 +198,85 @@ TEST_F(RuleParserTest, ParseNestedConditionsRule) {
     event4.data["severity"] = 9;
     ASSERT_FALSE(rule->check(event4));
 }
+
+// Test case: Bytecode của Rule cho cùng kết quả với cây điều kiện (kể cả NOT, AND/OR rỗng, key thiếu)
+TEST_F(RuleParserTest, CompiledProgramMatchesConditionTree) {
+    nlohmann::json rule_json = R"(
+    {
+        "id": "compiled_rule",
+        "condition": {
+            "or": [
+                {
+                    "and": [
+                        {"key": "level", "operator": ">", "value": 5},
+                        {"not": {"key": "muted", "operator": "==", "value": true}}
+                    ]
+                },
+                {"and": [{"key": "severity", "operator": ">=", "value": 8}, {"and": []}]},
+                {"or": []}
+            ]
+        },
+        "actions": []
+    }
+    )"_json;
+
+    auto rule = RuleParser::parse(rule_json);
+    ASSERT_NE(rule, nullptr);
+    ASSERT_NE(rule->getProgram(), nullptr);
+    ASSERT_NE(rule->getCondition(), nullptr);
+    ASSERT_EQ(rule->getProgram()->code().back().op, ConditionProgram::OpCode::Return);
+
+    for (int level : {0, 10}) {
+        for (int muted : {-1, 0, 1}) {       // -1: không có key "muted"
+            for (int severity : {-1, 5, 9}) { // -1: không có key "severity"
+                Event event;
+                event.data["level"] = level;
+                if (muted >= 0) event.data["muted"] = (muted == 1);
+                if (severity >= 0) event.data["severity"] = severity;
+                ASSERT_EQ(rule->getProgram()->run(event), rule->getCondition()->evaluate(event))
+                    << rule->getProgram()->disassemble();
+            }
+        }
+    }
+}
+
+// Test case: AND được biên dịch thành chuỗi lệnh phẳng với nhảy ngắn mạch
+TEST_F(RuleParserTest, CompiledAndDisassembly) {
+    nlohmann::json rule_json = R"(
+    {
+        "id": "and_rule",
+        "condition": {"and": [
+            {"key": "temperature", "operator": ">", "value": 30},
+            {"key": "location", "operator": "==", "value": "LivingRoom"}
+        ]},
+        "actions": []
+    }
+    )"_json;
+
+    auto rule = RuleParser::parse(rule_json);
+    ASSERT_EQ(rule->getProgram()->disassemble(),
+              "0: LoadKey temperature\n"
+              "1: CompareConst > 30\n"
+              "2: JumpIfFalse 5\n"
+              "3: LoadKey location\n"
+              "4: CompareConst == LivingRoom\n"
+              "5: Return\n");
+}
+
+// Test case: Hành động được tạo sẵn khi parse; loại hành động chưa đăng ký khiến quy tắc bị từ chối
+TEST_F(RuleParserTest, BuildsActionsAtParse) {
+    auto rule = RuleParser::parse(nlohmann::json::parse(R"({
+        "id": "two_actions",
+        "condition": {"key": "temperature", "operator": ">", "value": 30},
+        "actions": [{"type": "log", "message": "a"}, {"type": "log", "message": "b"}]
+    })"));
+    ASSERT_EQ(rule->getActions().size(), 2u);
+    ASSERT_NE(rule->getActions()[0], nullptr);
+    ASSERT_NE(rule->getActions()[0], rule->getActions()[1]);
+
+    ASSERT_THROW(RuleParser::parse(nlohmann::json::parse(R"({
+        "id": "bad_action",
+        "condition": {"key": "temperature", "operator": ">", "value": 30},
+        "actions": [{"type": "no_such_action"}]
+    })")), std::runtime_error);
+}
@@ -0,0 +1,128 @@
+// tests/RuleSetTest.cpp
+#include "gtest/gtest.h"
+#include "rules/RuleManager.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Định nghĩa trong actions/ActionFactory.cpp.
+extern void registerAllDefaultActions();
+
+// Ghi bộ quy tắc ra file tạm và tải vào RuleManager
+static void loadRulesFromJson(const std::string& rules) {
+    registerAllDefaultActions();
+    const std::string path = "rule_set_test_rules.json";
+    {
+        std::ofstream file(path);
+        file << rules;
+    }
+    RuleManager::getInstance().loadRules(path);
+    std::remove(path.c_str());
+}
+
+static const char* kRulesA = R"([
+    {"id": "a", "condition": {"key": "temperature", "operator": ">", "value": 30}, "actions": [{"type": "log", "message": "A"}]}
+])";
+
+static const char* kRulesB = R"([
+    {"id": "b1", "condition": {"key": "temperature", "operator": ">", "value": 10}, "actions": [{"type": "log", "message": "B1"}]},
+    {"id": "b2", "condition": {"key": "temperature", "operator": "<", "value": 100}, "actions": [{"type": "log", "message": "B2"}]}
+])";
+
+// Test case: RuleSet đã lấy ra vẫn đánh giá theo bộ quy tắc cũ sau khi tải lại
+TEST(RuleSetTest, SnapshotSurvivesReload) {
+    loadRulesFromJson(kRulesA);
+    std::shared_ptr<const RuleSet> snapshot = RuleManager::getInstance().getRuleSet();
+    ASSERT_NE(snapshot, nullptr);
+
+    loadRulesFromJson(kRulesB);
+    ASSERT_EQ(RuleManager::getInstance().getRulesCount(), 2u);
+
+    Event event;
+    event.data["temperature"] = 50;
+    ASSERT_EQ(snapshot->rules().size(), 1u);
+    std::vector<ActionCommandRef> actions = snapshot->evaluate(event);
+    ASSERT_EQ(actions.size(), 1u);
+    ASSERT_EQ(actions[0], snapshot->rules()[0].getActions()[0]); // Hành động tạo sẵn, không tạo lại
+    ASSERT_EQ(RuleManager::getInstance().evaluate(event).size(), 2u);
+}
+
+// Test case: Nhiều luồng đánh giá song song trong khi tải lại liên tục;
+// mỗi lần đánh giá thấy trọn vẹn bộ quy tắc cũ hoặc mới, không bao giờ lẫn lộn
+TEST(RuleSetTest, ConcurrentEvaluationDuringReload) {
+    loadRulesFromJson(kRulesA);
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::atomic<int> evaluations{0};
+
+    std::vector<std::thread> evaluators;
+    for (int t = 0; t < 4; ++t) {
+        evaluators.emplace_back([&] {
+            Event event;
+            event.data["temperature"] = 50;
+            while (!done.load()) {
+                // Giữ RuleSet để so sánh hành động trả về với hành động của chính các quy tắc trong đó
+                std::shared_ptr<const RuleSet> ruleset = RuleManager::getInstance().getRuleSet();
+                std::vector<ActionCommandRef> actions = ruleset->evaluate(event);
+                const std::vector<Rule>& rules = ruleset->rules();
+                bool is_a = rules.size() == 1 && rules[0].getId() == "a" &&
+                            actions == rules[0].getActions();
+                bool is_b = rules.size() == 2 && rules[0].getId() == "b1" && rules[1].getId() == "b2" &&
+                            actions == std::vector<ActionCommandRef>{rules[0].getActions()[0], rules[1].getActions()[0]};
+                if (!is_a && !is_b) {
+                    inconsistent.fetch_add(1);
+                }
+                evaluations.fetch_add(1);
+            }
+        });
+    }
+
+    for (int i = 0; i < 20; ++i) {
+        loadRulesFromJson(i % 2 == 0 ? kRulesB : kRulesA);
+        RuleManager::getInstance().setEvaluationMode(i % 3 == 0 ? RuleManager::EvaluationMode::AlphaNetwork
+                                                                : RuleManager::EvaluationMode::Linear);
+    }
+    done.store(true);
+    for (auto& evaluator : evaluators) {
+        evaluator.join();
+    }
+    RuleManager::getInstance().setEvaluationMode(RuleManager::EvaluationMode::Linear);
+
+    ASSERT_GT(evaluations.load(), 0);
+    ASSERT_EQ(inconsistent.load(), 0);
+}
+
+// Test case: Với nhiều loadRules đồng thời, listener nhận IngestFilter theo đúng thứ tự đổi RuleSet,
+// nên filter cuối cùng listener giữ luôn là filter của RuleSet đang hiện hành
+TEST(RuleSetTest, IngestFilterListenersFollowPublishOrder) {
+    registerAllDefaultActions();
+    // Listener sống cùng RuleManager (không hủy đăng ký được), nên trạng thái được giữ qua shared_ptr
+    auto last_filter = std::make_shared<std::shared_ptr<const IngestFilter>>();
+    RuleManager::getInstance().subscribeIngestFilter([last_filter](std::shared_ptr<const IngestFilter> filter) {
+        std::atomic_store(last_filter.get(), std::move(filter));
+    });
+
+    std::vector<std::thread> loaders;
+    for (int t = 0; t < 4; ++t) {
+        loaders.emplace_back([t] {
+            for (int i = 0; i < 10; ++i) {
+                const std::string path = "rule_set_order_" + std::to_string(t) + ".json";
+                {
+                    std::ofstream file(path);
+                    file << ((i + t) % 2 == 0 ? kRulesA : kRulesB);
+                }
+                RuleManager::getInstance().loadRules(path);
+                std::remove(path.c_str());
+            }
+        });
+    }
+    for (auto& loader : loaders) {
+        loader.join();
+    }
+    ASSERT_EQ(std::atomic_load(last_filter.get()), RuleManager::getInstance().getIngestFilter());
+}
@@ -0,0 +1,92 @@
+// tests/ThreadPoolTest.cpp
+#include "gtest/gtest.h"
+#include "action_dispatcher/ThreadPool.h"
+#include "action_dispatcher/Task.h"
+#include "action_dispatcher/WorkStealingDeque.h"
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Test case: Deque của owner là LIFO, thief lấy phần tử cũ nhất; buffer tự mở rộng khi đầy
+TEST(ThreadPoolTest, DequeOwnerLifoThiefFifo) {
+    WorkStealingDeque<int> deque(2);
+    std::vector<int> values(10);
+    for (auto& value : values) {
+        deque.push(&value);
+    }
+    ASSERT_EQ(deque.sizeApprox(), 10);
+    ASSERT_EQ(deque.pop(), &values[9]);
+    ASSERT_EQ(deque.steal(), &values[0]);
+    ASSERT_EQ(deque.steal(), &values[1]);
+    while (deque.pop() != nullptr) {
+    }
+    ASSERT_EQ(deque.steal(), nullptr);
+}
+
+// Test case: enqueue trả future mang kết quả hoặc exception; submit không cần future
+TEST(ThreadPoolTest, EnqueueAndSubmit) {
+    ThreadPool pool(3);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; ++i) {
+        results.push_back(pool.enqueue([i] { return i * i; }));
+    }
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(results[i].get(), i * i);
+    }
+    auto failed = pool.enqueue([]() -> int { throw std::runtime_error("boom"); });
+    ASSERT_THROW(failed.get(), std::runtime_error);
+
+    std::promise<void> done;
+    pool.submit([] { throw std::runtime_error("ignored"); }); // Worker ghi log và tiếp tục
+    pool.submit([&done] { done.set_value(); });
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
+
+// Test case: Task sinh thêm task từ luồng worker (vào deque riêng của worker đó); worker khác
+// phải lấy trộm chúng vì worker sinh task vẫn đang bận. Destructor chạy hết mọi task đã gửi.
+TEST(ThreadPoolTest, NestedTasksAreStolenAndDrained) {
+    std::atomic<int> executed{0};
+    {
+        ThreadPool pool(4);
+        pool.submit([&] {
+            for (int i = 0; i < 1000; ++i) {
+                pool.submit([&] { executed.fetch_add(1); });
+            }
+            // Chỉ thoát khi các worker khác đã lấy trộm và chạy một nửa số task
+            while (executed.load() < 500) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    ASSERT_EQ(executed.load(), 1000);
+}
+
+// Test case: Task chỉ di chuyển (move-only), lưu inline callable nhỏ và giữ được callable lớn trên heap
+TEST(ThreadPoolTest, TaskStoresMoveOnlyCallables) {
+    auto value = std::make_unique<int>(7);
+    int seen = 0;
+    Task small([value = std::move(value), &seen] { seen = *value; });
+    static_assert(Task::fitsInline<std::packaged_task<int()>>(), "enqueue stores packaged_task inline");
+
+    Task moved = std::move(small);
+    ASSERT_FALSE(small);
+    moved();
+    ASSERT_EQ(seen, 7);
+
+    struct Large {
+        char payload[Task::kInlineSize * 2] = {};
+        int* out;
+        void operator()() { *out = sizeof(payload); }
+    };
+    static_assert(!Task::fitsInline<Large>(), "Large callable goes to the heap");
+    Task large(Large{{}, &seen});
+    Task other;
+    other = std::move(large);
+    other();
+    ASSERT_EQ(seen, static_cast<int>(Task::kInlineSize * 2));
+    other.reset();
+    ASSERT_FALSE(other);
+}